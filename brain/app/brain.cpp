@@ -61,7 +61,7 @@ int main(int argc, char **argv) {
     // ---- Core components ----
     boost::asio::io_context ioc;
 
-    brain::UnifiedBook book(opts.depth);
+    brain::UnifiedBook book(opts.depth, opts.book);
     const std::uint64_t output_max_bytes =
         opts.output_max_mb > 0 ? opts.output_max_mb * 1024ULL * 1024ULL : 0;
 
@@ -79,8 +79,13 @@ int main(int argc, char **argv) {
     auto on_message = [&](std::string_view msg) {
         try {
             const auto j = nlohmann::json::parse(msg);
-            const std::string updated = book.on_event(j);
-            if (!updated.empty() && book.synced_count() >= 2)
+            md::BookChange change;
+            const std::string updated = book.on_event(j, &change);
+            // Every event refreshes the venue's book age, so with an age guard or rate limit a standing
+            // cross can become emittable without any price moving: scan on every event then. Without
+            // either, only a best bid/ask price change (or a venue turning healthy, reported as one by
+            // UnifiedBook) can create a new cross, and deep-book / qty-only updates skip the scan.
+            if (!updated.empty() && (change.bboPrice || arb.time_gated()) && book.synced_count() >= 2)
                 arb.scan(book.venues());
         } catch (const nlohmann::json::exception &e) {
             spdlog::warn("[brain] JSON parse error: {}", e.what());
@@ -91,7 +96,7 @@ int main(int argc, char **argv) {
     const auto addr = boost::asio::ip::make_address(opts.bind);
     const boost::asio::ip::tcp::endpoint ep(addr, opts.port);
 
-    brain::WsServer server(ioc, ssl_ctx, ep, on_message);
+    brain::WsServer server(ioc, ssl_ctx, ep, on_message, opts.ws_deflate, opts.socket);
     server.start();
 
     // ---- D4: brain watchdog ----
@@ -126,6 +131,7 @@ int main(int argc, char **argv) {
                 }
             }
 
+            server.log_traffic();
             arm_watchdog();
         });
     };
@@ -142,9 +148,11 @@ int main(int argc, char **argv) {
         md::log::flush();
     });
 
-    spdlog::info("[brain] running depth={} min_spread={}bps max_spread={} rate_limit={} "
+    spdlog::info("[brain] running depth={} book={} reserve={} min_spread={}bps max_spread={} rate_limit={} "
                  "max_age={}ms max_price_dev={} output_max={} watchdog_no_cross={} mtls={}",
         opts.depth,
+        md::to_string(opts.book.kind),
+        opts.book.reserve_levels,
         opts.min_spread_bps,
         opts.max_spread_bps > 0.0 ? std::to_string(opts.max_spread_bps) + "bps" : "no-cap",
         opts.rate_limit_ms > 0 ? std::to_string(opts.rate_limit_ms) + "ms" : "off",
@@ -54,6 +54,10 @@ public:
         spdlog::info("[ArbDetector] total crosses emitted: {}", crosses_total_);
     }
 
+    /// True when a cross can be held back by time alone (book age guard or per-pair rate limit),
+    /// i.e. a rescan may emit it without any best price having changed.
+    [[nodiscard]] bool time_gated() const noexcept { return rate_limit_ns_ > 0 || max_age_diff_ns_ > 0; }
+
     /// D4: timestamp of the last emitted cross (0 if none yet).
     [[nodiscard]] std::int64_t last_cross_ns() const noexcept { return last_cross_ns_; }
 
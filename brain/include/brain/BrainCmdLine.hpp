@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <boost/program_options.hpp>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <string>
 
+#include "connection_handler/SocketOptions.hpp"
+#include "connection_handler/WsDeflate.hpp"
+#include "orderbook/OrderBook.hpp"
+
 namespace brain {
 
 struct BrainOptions {
@@ -24,6 +29,9 @@ struct BrainOptions {
     std::size_t output_max_mb{0};             ///< D3: rotate arb output after N MB (0 = no rotation)
     std::int64_t watchdog_no_cross_sec{0};    ///< D4: warn if no cross in this many seconds (0 = disabled)
     std::size_t depth{50};      ///< OrderBook depth per venue
+    md::BookOptions book{};     ///< OrderBook layout (sorted | ladder) per venue
+    md::WsDeflateOptions ws_deflate{}; ///< permessage-deflate accepted from PoP clients
+    md::SocketOptions socket{};        ///< kernel options for accepted PoP sockets
     bool        show_help{false};
 };
 
@@ -63,6 +71,32 @@ inline bool parse_brain_cmdline(int argc, char **argv, BrainOptions &out) {
                           "D4: log WARN if no arb cross detected in this many seconds (0=disabled)")
         ("depth",         po::value<std::size_t>()->default_value(50),
                           "OrderBook depth per venue")
+        ("book-kind",     po::value<std::string>()->default_value("sorted"),
+                          "OrderBook layout: sorted | ladder")
+        ("ladder-ticks",  po::value<std::size_t>()->default_value(8192),
+                          "Ladder book window width in ticks (rounded up to a power of two)")
+        ("book-reserve-levels", po::value<std::size_t>()->default_value(0),
+                          "Levels kept beyond --depth per venue (not used for arb) so the book refills after cancels")
+        ("ws-deflate",    po::value<bool>()->default_value(false),
+                          "Accept permessage-deflate from PoP clients that offer it")
+        ("ws-deflate-window-bits", po::value<int>()->default_value(15),
+                          "permessage-deflate LZ77 window bits, 9..15")
+        ("ws-deflate-no-context-takeover", po::value<bool>()->default_value(false),
+                          "Reset the deflate context per message (less memory per session, worse ratio)")
+        ("ws-deflate-level", po::value<int>()->default_value(6),
+                          "Compression level for frames brain sends, 0..9 (0 = send uncompressed)")
+        ("sock-nodelay",  po::value<bool>()->default_value(true),
+                          "TCP_NODELAY on accepted PoP sockets")
+        ("sock-rcvbuf",   po::value<int>()->default_value(0),
+                          "SO_RCVBUF bytes for accepted sockets (0 = kernel default / autotuning)")
+        ("sock-sndbuf",   po::value<int>()->default_value(0),
+                          "SO_SNDBUF bytes for accepted sockets (0 = kernel default / autotuning)")
+        ("sock-busy-poll-us", po::value<int>()->default_value(0),
+                          "SO_BUSY_POLL microseconds (Linux; 0 = off)")
+        ("sock-quickack", po::value<bool>()->default_value(false),
+                          "TCP_QUICKACK, re-armed after every read (Linux)")
+        ("sock-tos",      po::value<int>()->default_value(-1),
+                          "IP TOS / traffic class byte for accepted sockets (-1 = leave)")
         ("log-level",     po::value<std::string>()->default_value("info"),
                           "D1: log verbosity: debug | info | warn | error");
 
@@ -104,6 +138,22 @@ inline bool parse_brain_cmdline(int argc, char **argv, BrainOptions &out) {
     out.output_max_mb = vm["output-max-mb"].as<std::size_t>();
     out.watchdog_no_cross_sec = vm["watchdog-no-cross-sec"].as<std::int64_t>();
     out.depth         = vm["depth"].as<std::size_t>();
+    if (!md::parse_book_kind(vm["book-kind"].as<std::string>(), out.book.kind)) {
+        std::cerr << "[brain] --book-kind must be sorted or ladder\n";
+        return false;
+    }
+    out.book.ladder_ticks = vm["ladder-ticks"].as<std::size_t>();
+    out.book.reserve_levels = vm["book-reserve-levels"].as<std::size_t>();
+    out.ws_deflate.enabled = vm["ws-deflate"].as<bool>();
+    out.ws_deflate.window_bits = vm["ws-deflate-window-bits"].as<int>();
+    out.ws_deflate.no_context_takeover = vm["ws-deflate-no-context-takeover"].as<bool>();
+    out.ws_deflate.level = vm["ws-deflate-level"].as<int>();
+    out.socket.tcp_nodelay = vm["sock-nodelay"].as<bool>();
+    out.socket.rcvbuf = std::max(0, vm["sock-rcvbuf"].as<int>());
+    out.socket.sndbuf = std::max(0, vm["sock-sndbuf"].as<int>());
+    out.socket.busy_poll_us = std::max(0, vm["sock-busy-poll-us"].as<int>());
+    out.socket.quickack = vm["sock-quickack"].as<bool>();
+    out.socket.tos = std::clamp(vm["sock-tos"].as<int>(), -1, 255);
     out.log_level = vm["log-level"].as<std::string>();
     if (vm.count("certfile"))   out.certfile   = vm["certfile"].as<std::string>();
     if (vm.count("keyfile"))    out.keyfile    = vm["keyfile"].as<std::string>();
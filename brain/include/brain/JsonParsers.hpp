@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -33,16 +34,24 @@ inline EventHeader parse_header(const nlohmann::json &j) {
     return h;
 }
 
+/// View of an optional string member; empty if absent. Throws like value() on a non-string.
+inline std::string_view text_field(const nlohmann::json &obj, const char *key) {
+    const auto it = obj.find(key);
+    if (it == obj.end()) return {};
+    return it->get_ref<const std::string &>();
+}
+
 /// Parse a single level object. priceTick/quantityLot are already integers
 /// in the wire format (pre-computed by WsPublishSink); no conversion needed.
+/// price/quantity are views into 'lvl': the DOM must outlive the returned level.
 /// Throws std::runtime_error on negative quantities or non-positive prices on
 /// non-removal levels (quantityLot > 0 requires priceTick > 0).
 inline Level parse_level(const nlohmann::json &lvl) {
     Level l;
     l.priceTick   = lvl.value("priceTick",   std::int64_t{0});
     l.quantityLot = lvl.value("quantityLot", std::int64_t{0});
-    l.price       = lvl.value("price",    std::string{});
-    l.quantity    = lvl.value("quantity", std::string{});
+    l.price       = text_field(lvl, "price");
+    l.quantity    = text_field(lvl, "quantity");
 
     // Sanity: negative quantity is never valid
     if (l.quantityLot < 0)
@@ -28,7 +28,7 @@ struct VenueBook {
     /// controller's internal state still shows Synced from the previous cycle.
     bool feed_healthy{false};
 
-    VenueBook(std::string venue, std::string symbol, std::size_t depth);
+    VenueBook(std::string venue, std::string symbol, std::size_t depth, const md::BookOptions &opts = {});
 
     // Non-copyable (unique_ptr member)
     VenueBook(const VenueBook &)            = delete;
@@ -44,18 +44,22 @@ struct VenueBook {
 /// Maintains one VenueBook per venue and routes incoming JSON events.
 class UnifiedBook {
 public:
-    explicit UnifiedBook(std::size_t depth);
+    explicit UnifiedBook(std::size_t depth, const md::BookOptions &opts = {});
 
     /// Route one JSON event (snapshot / incremental / book_state) to the
     /// appropriate VenueBook. Returns the updated venue name, or "" if the
     /// event was discarded (unknown type, parse error, missing venue field).
-    std::string on_event(const nlohmann::json &j);
+    /// 'change' (optional) receives what the event did to that venue's book: the controller's
+    /// summary for incrementals, md::BookChange::all() for snapshot / book_state / status events
+    /// and for any event that turns an unhealthy venue healthy again.
+    std::string on_event(const nlohmann::json &j, md::BookChange *change = nullptr);
 
     [[nodiscard]] const std::vector<VenueBook> &venues() const noexcept { return books_; }
     [[nodiscard]] std::size_t synced_count() const noexcept;
 
 private:
     std::size_t depth_;
+    md::BookOptions book_opts_;
     std::vector<VenueBook> books_; ///< at most N_venues entries; linear lookup is fine
 
     VenueBook *find_or_create_(const std::string &venue, const std::string &symbol);
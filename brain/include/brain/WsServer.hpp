@@ -14,6 +14,10 @@
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/websocket/ssl.hpp>
 
+#include "connection_handler/MeteredStream.hpp"
+#include "connection_handler/SocketOptions.hpp"
+#include "connection_handler/WsDeflate.hpp"
+
 namespace brain {
 
 class WsSession;
@@ -27,7 +31,9 @@ public:
     WsServer(boost::asio::io_context &ioc,
              boost::asio::ssl::context &ssl_ctx,
              boost::asio::ip::tcp::endpoint endpoint,
-             MessageHandler on_message);
+             MessageHandler on_message,
+             md::WsDeflateOptions deflate = {},
+             md::SocketOptions socket_opts = {});
 
     /// Start accepting connections. Must be called before ioc.run().
     void start();
@@ -35,6 +41,9 @@ public:
     /// Stop accepting and close all active sessions.
     void stop();
 
+    /// Log the traffic counters (payload vs wire bytes, codec time) of every live session.
+    void log_traffic();
+
 private:
     void do_accept_();
     void on_accept_(boost::beast::error_code ec,
@@ -44,6 +53,8 @@ private:
     boost::asio::ssl::context        &ssl_ctx_;
     boost::asio::ip::tcp::acceptor    acceptor_;
     MessageHandler                    on_message_;
+    md::WsDeflateOptions              deflate_;
+    md::SocketOptions                 socket_opts_;
     std::vector<std::weak_ptr<WsSession>> sessions_;
     bool stopped_{false};
 };
@@ -54,21 +65,29 @@ private:
 ///   run() → TLS handshake → WS accept → read loop
 class WsSession : public std::enable_shared_from_this<WsSession> {
 public:
-    using WsStream = boost::beast::websocket::stream<
-                         boost::beast::ssl_stream<boost::asio::ip::tcp::socket>>;
+    using TlsStream = boost::beast::ssl_stream<boost::asio::ip::tcp::socket>;
+    using Meter     = md::MeteredStream<TlsStream>;
+    using WsStream  = boost::beast::websocket::stream<Meter>;
 
     static std::shared_ptr<WsSession> create(
         boost::asio::ip::tcp::socket      socket,
         boost::asio::ssl::context        &ssl_ctx,
-        WsServer::MessageHandler          on_message);
+        WsServer::MessageHandler          on_message,
+        const md::WsDeflateOptions       &deflate,
+              const md::SocketOptions          &socket_opts);
 
     void run();
     void close();
 
+    const md::WsTraffic &traffic() const noexcept { return ws_.next_layer().traffic(); }
+    const std::string   &remote_addr() const noexcept { return remote_addr_; }
+
 private:
     WsSession(boost::asio::ip::tcp::socket      socket,
               boost::asio::ssl::context        &ssl_ctx,
-              WsServer::MessageHandler          on_message);
+              WsServer::MessageHandler          on_message,
+              const md::WsDeflateOptions       &deflate,
+              const md::SocketOptions          &socket_opts);
 
     void do_tls_handshake_();
     void do_ws_accept_();
@@ -78,6 +97,8 @@ private:
     WsStream                    ws_;
     boost::beast::flat_buffer   buffer_;
     WsServer::MessageHandler    on_message_;
+    md::WsDeflateOptions        deflate_;
+    md::SocketOptions           socket_opts_;
     std::string                 remote_addr_;
 };
 
@@ -38,10 +38,10 @@ inline std::int64_t sanitize_ts(std::int64_t ts, std::string_view venue) noexcep
 // ---------------------------------------------------------------------------
 // VenueBook
 
-VenueBook::VenueBook(std::string name, std::string sym, std::size_t depth)
+VenueBook::VenueBook(std::string name, std::string sym, std::size_t depth, const md::BookOptions &opts)
     : venue_name(std::move(name)),
       symbol(std::move(sym)),
-      controller(std::make_unique<md::OrderBookController>(depth)) {
+      controller(std::make_unique<md::OrderBookController>(depth, opts)) {
     // Brain joins mid-stream: allow sequence gaps on all controllers.
     // No checksum function: PoP has already validated.
     controller->setAllowSequenceGap(true);
@@ -58,13 +58,14 @@ const md::OrderBook &VenueBook::book() const noexcept {
 // ---------------------------------------------------------------------------
 // UnifiedBook
 
-UnifiedBook::UnifiedBook(std::size_t depth) : depth_(depth) {}
+UnifiedBook::UnifiedBook(std::size_t depth, const md::BookOptions &opts)
+    : depth_(depth), book_opts_(opts) {}
 
 VenueBook *UnifiedBook::find_or_create_(const std::string &venue, const std::string &symbol) {
     for (auto &vb : books_) {
         if (vb.venue_name == venue && vb.symbol == symbol) return &vb;
     }
-    books_.emplace_back(venue, symbol, depth_);
+    books_.emplace_back(venue, symbol, depth_, book_opts_);
     spdlog::info("[UnifiedBook] registered new venue+symbol: {}:{}", venue, symbol);
     return &books_.back();
 }
@@ -76,7 +77,7 @@ std::size_t UnifiedBook::synced_count() const noexcept {
     return n;
 }
 
-std::string UnifiedBook::on_event(const nlohmann::json &j) {
+std::string UnifiedBook::on_event(const nlohmann::json &j, md::BookChange *change) {
     EventHeader hdr;
     try {
         hdr = parse_header(j);
@@ -87,6 +88,8 @@ std::string UnifiedBook::on_event(const nlohmann::json &j) {
     if (hdr.venue.empty() || hdr.event_type.empty()) return {};
 
     VenueBook *vb = find_or_create_(hdr.venue, hdr.symbol);
+    const bool was_healthy = vb->feed_healthy;
+    md::BookChange applied = md::BookChange::all();
 
     try {
         if (hdr.event_type == "snapshot") {
@@ -105,7 +108,7 @@ std::string UnifiedBook::on_event(const nlohmann::json &j) {
             auto inc = parse_incremental(j);
             vb->ts_book_ns   = sanitize_ts(inc.ts_recv_ns, hdr.venue);
             vb->feed_healthy = true;
-            const auto action = vb->controller->onIncrement(inc);
+            const auto action = vb->controller->onIncrement(inc, &applied);
             if (action == md::OrderBookController::Action::NeedResync)
                 spdlog::warn("[UnifiedBook] NeedResync after incremental venue={} — awaiting next book_state",
                              hdr.venue);
@@ -149,6 +152,11 @@ std::string UnifiedBook::on_event(const nlohmann::json &j) {
         return {};
     }
 
+    // A venue coming back to health re-enters the scan with its current prices: report that as a
+    // full change even when the event itself only touched deep levels.
+    if (!was_healthy && vb->feed_healthy) applied = md::BookChange::all();
+
+    if (change) *change = applied;
     return hdr.venue;
 }
 
@@ -21,11 +21,15 @@ namespace brain {
 WsServer::WsServer(net::io_context &ioc,
                    ssl::context    &ssl_ctx,
                    tcp::endpoint    endpoint,
-                   MessageHandler   on_message)
+                   MessageHandler   on_message,
+                   md::WsDeflateOptions deflate,
+                   md::SocketOptions socket_opts)
     : ioc_(ioc),
       ssl_ctx_(ssl_ctx),
       acceptor_(ioc),           // bind to io_context directly
-      on_message_(std::move(on_message)) {
+      on_message_(std::move(on_message)),
+      deflate_(deflate),
+      socket_opts_(socket_opts) {
     beast::error_code ec;
 
     acceptor_.open(endpoint.protocol(), ec);
@@ -40,7 +44,9 @@ WsServer::WsServer(net::io_context &ioc,
     acceptor_.listen(net::socket_base::max_listen_connections, ec);
     if (ec) { spdlog::error("[WsServer] listen: {}", ec.message()); return; }
 
-    spdlog::info("[WsServer] listening on {}:{}", endpoint.address().to_string(), endpoint.port());
+    spdlog::info("[WsServer] listening on {}:{} permessage_deflate={} socket={}",
+                 endpoint.address().to_string(), endpoint.port(), md::describe(deflate_),
+                 md::describe(socket_opts_));
 }
 
 void WsServer::start() {
@@ -65,6 +71,13 @@ void WsServer::stop() {
     sessions_.clear();
 }
 
+void WsServer::log_traffic() {
+    for (const auto &wptr : sessions_) {
+        if (auto sp = wptr.lock())
+            spdlog::info("[WsServer] traffic addr={} {}", sp->remote_addr(), md::describe(sp->traffic()));
+    }
+}
+
 void WsServer::do_accept_() {
     if (stopped_) return;
 
@@ -97,7 +110,10 @@ void WsServer::on_accept_(beast::error_code ec, tcp::socket socket) {
         return;
     }
 
-    auto session = WsSession::create(std::move(socket), ssl_ctx_, on_message_);
+    const std::string failed = md::applySocketOptions(socket, socket_opts_);
+    if (!failed.empty()) spdlog::warn("[WsServer] socket options: {}", failed);
+
+    auto session = WsSession::create(std::move(socket), ssl_ctx_, on_message_, deflate_, socket_opts_);
     sessions_.emplace_back(session);
     session->run();
 
@@ -109,11 +125,15 @@ void WsServer::on_accept_(beast::error_code ec, tcp::socket socket) {
 
 WsSession::WsSession(tcp::socket      socket,
                      ssl::context    &ssl_ctx,
-                     WsServer::MessageHandler on_message)
+                     WsServer::MessageHandler on_message,
+                     const md::WsDeflateOptions &deflate,
+                     const md::SocketOptions &socket_opts)
     : ws_(std::move(socket), ssl_ctx),
-      on_message_(std::move(on_message)) {
+      on_message_(std::move(on_message)),
+      deflate_(deflate),
+      socket_opts_(socket_opts) {
     try {
-        remote_addr_ = ws_.next_layer().next_layer().remote_endpoint()
+        remote_addr_ = beast::get_lowest_layer(ws_).remote_endpoint()
                           .address().to_string();
     } catch (...) {
         remote_addr_ = "<unknown>";
@@ -123,10 +143,12 @@ WsSession::WsSession(tcp::socket      socket,
 std::shared_ptr<WsSession> WsSession::create(
     tcp::socket              socket,
     ssl::context            &ssl_ctx,
-    WsServer::MessageHandler on_message)
+    WsServer::MessageHandler on_message,
+    const md::WsDeflateOptions &deflate,
+    const md::SocketOptions &socket_opts)
 {
     return std::shared_ptr<WsSession>(
-        new WsSession(std::move(socket), ssl_ctx, std::move(on_message)));
+        new WsSession(std::move(socket), ssl_ctx, std::move(on_message), deflate, socket_opts));
 }
 
 void WsSession::run() {
@@ -138,11 +160,11 @@ void WsSession::run() {
 
 void WsSession::close() {
     beast::error_code ec;
-    ws_.next_layer().next_layer().close(ec);
+    beast::get_lowest_layer(ws_).close(ec);
 }
 
 void WsSession::do_tls_handshake_() {
-    ws_.next_layer().async_handshake(
+    ws_.next_layer().next_layer().async_handshake(
         ssl::stream_base::server,
         [self = shared_from_this()](beast::error_code ec) {
             if (ec) { self->fail_(ec, "tls_handshake"); return; }
@@ -157,7 +179,9 @@ void WsSession::do_ws_accept_() {
             res.set(boost::beast::http::field::server, "brain/1.0");
         }
     ));
+    ws_.set_option(md::toPermessageDeflate(deflate_, /*server=*/true));
 
+    Meter::CodecScope codec(ws_.next_layer());
     ws_.async_accept(
         [self = shared_from_this()](beast::error_code ec) {
             if (ec) { self->fail_(ec, "ws_accept"); return; }
@@ -169,6 +193,7 @@ void WsSession::do_ws_accept_() {
 }
 
 void WsSession::do_read_() {
+    Meter::CodecScope codec(ws_.next_layer());
     ws_.async_read(
         buffer_,
         [self = shared_from_this()](beast::error_code ec, std::size_t /*bytes*/) {
@@ -177,12 +202,16 @@ void WsSession::do_read_() {
                     ec != net::error::operation_aborted)
                     self->fail_(ec, "read");
                 else
-                    spdlog::info("[WsServer] client disconnected addr={}", self->remote_addr_);
+                    spdlog::info("[WsServer] client disconnected addr={} {}",
+                                 self->remote_addr_, md::describe(self->traffic()));
                 return;
             }
 
+            md::rearmQuickAck(beast::get_lowest_layer(self->ws_), self->socket_opts_);
+            self->ws_.next_layer().traffic().payload_in += self->buffer_.size();
             if (self->ws_.got_text()) {
                 const std::string data = beast::buffers_to_string(self->buffer_.data());
+                Meter::UserScope user(self->ws_.next_layer());
                 try {
                     self->on_message_(std::string_view{data});
                 } catch (...) {}
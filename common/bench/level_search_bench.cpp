@@ -0,0 +1,98 @@
+/**
+ * Micro-benchmark: insertion-point search on one book side, std::lower_bound vs level_search.
+ * Build with -DPOP_BUILD_BENCH=ON, run ./common/level_search_bench [iterations].
+ * Query ticks are drawn two ways:
+ * - near:    geometric around the touch (what live feeds look like: most updates hit the first levels)
+ * - uniform: anywhere across the side (worst case for the predictor)
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "orderbook/LevelSearch.hpp"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t stdLowerBound(const std::vector<BookLevel> &side, std::int64_t tick) {
+        return static_cast<std::size_t>(
+            std::lower_bound(side.begin(), side.end(), tick,
+                             [](const BookLevel &l, std::int64_t t) { return l.priceTick > t; }) - side.begin());
+    }
+
+#ifdef MD_LEVEL_SEARCH_X86
+    /// Same narrowing as level_search::lowerBound, but the window count is pinned to SSE2.
+    std::size_t sse2LowerBound(const std::vector<BookLevel> &side, std::int64_t tick) {
+        const BookLevel *p = side.data();
+        std::size_t n = side.size(), first = 0;
+        while (n > md::level_search::kWindow) {
+            const std::size_t half = n / 2;
+            first = (p[first + half].priceTick > tick) ? first + half : first;
+            n -= half;
+        }
+        return first + md::level_search::countBetterSse2<Side::BID>(p + first, n, tick);
+    }
+#endif
+
+    template<typename Fn>
+    double run(const std::vector<BookLevel> &side, const std::vector<std::int64_t> &queries,
+               std::size_t iterations, Fn &&fn, std::size_t &sink) {
+        const auto t0 = Clock::now();
+        for (std::size_t it = 0; it < iterations; ++it)
+            for (const std::int64_t q: queries) sink += fn(side, q);
+        const auto t1 = Clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        return ns / static_cast<double>(iterations * queries.size());
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    constexpr std::int64_t kTop = 10'000'000;
+    constexpr std::size_t kQueries = 1 << 14;
+
+    std::mt19937_64 rng(12345);
+    std::size_t sink = 0;
+
+    std::printf("%-6s %-8s %12s %12s %12s\n", "depth", "queries", "lower_bound", "sse2", "dispatch");
+    for (const std::size_t depth: {std::size_t{20}, std::size_t{50}, std::size_t{400}}) {
+        /// bid side, descending, with gaps of 1..3 ticks
+        std::vector<BookLevel> side;
+        std::int64_t tick = kTop;
+        for (std::size_t i = 0; i < depth; ++i) {
+            side.push_back(BookLevel{tick, static_cast<std::int64_t>(rng() % 1000 + 1)});
+            tick -= static_cast<std::int64_t>(rng() % 3 + 1);
+        }
+        const std::int64_t span = kTop - side.back().priceTick + 2;
+
+        for (const bool near: {true, false}) {
+            std::vector<std::int64_t> queries(kQueries);
+            std::geometric_distribution<std::int64_t> geo(0.15);
+            for (std::int64_t &q: queries)
+                q = near ? kTop + 1 - geo(rng) : kTop + 1 - static_cast<std::int64_t>(rng() % span);
+
+            const double base = run(side, queries, iterations, stdLowerBound, sink);
+#ifdef MD_LEVEL_SEARCH_X86
+            const double sse2 = run(side, queries, iterations, sse2LowerBound, sink);
+#else
+            const double sse2 = 0.0;
+#endif
+            const double simd = run(side, queries, iterations,
+                                    [](const std::vector<BookLevel> &s, std::int64_t q) {
+                                        return md::level_search::lowerBound<Side::BID>(s.data(), s.size(), q);
+                                    }, sink);
+            std::printf("%-6zu %-8s %9.2f ns %9.2f ns %9.2f ns\n", depth, near ? "near" : "uniform", base, sse2,
+                        simd);
+        }
+    }
+#ifdef MD_LEVEL_SEARCH_X86
+    std::printf("avx2=%s sink=%zu\n", md::level_search::kHasAvx2 ? "yes" : "no", sink);
+#else
+    std::printf("avx2=n/a sink=%zu\n", sink);
+#endif
+    return 0;
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/websocket/teardown.hpp>
+
+namespace md {
+    /**
+     * Traffic of one WebSocket connection.
+     * - payload_*: message bytes as the application sees them (uncompressed)
+     * - wire_*: WebSocket frame bytes below the deflate / framing layer (TLS records excluded)
+     * - codec_ns: time spent in the WebSocket layer itself (framing, masking, permessage-deflate),
+     *   measured around its completions and initiations with the application callbacks taken out.
+     *   Approximate: TLS records already buffered may be processed inside these windows.
+     */
+    struct WsTraffic {
+        std::uint64_t payload_in{0};
+        std::uint64_t payload_out{0};
+        std::uint64_t wire_in{0};
+        std::uint64_t wire_out{0};
+        std::int64_t codec_ns{0};
+    };
+
+    inline std::string describe(const WsTraffic &t) {
+        auto ratio = [](std::uint64_t wire, std::uint64_t payload) {
+            return payload ? static_cast<double>(wire) / static_cast<double>(payload) : 0.0;
+        };
+        char buf[256];
+        std::snprintf(buf, sizeof(buf),
+                      "payload_in=%llu wire_in=%llu in_ratio=%.3f payload_out=%llu wire_out=%llu out_ratio=%.3f codec_us=%lld",
+                      static_cast<unsigned long long>(t.payload_in), static_cast<unsigned long long>(t.wire_in),
+                      ratio(t.wire_in, t.payload_in),
+                      static_cast<unsigned long long>(t.payload_out), static_cast<unsigned long long>(t.wire_out),
+                      ratio(t.wire_out, t.payload_out),
+                      static_cast<long long>(t.codec_ns / 1000));
+        return buf;
+    }
+
+    /**
+     * Pass-through stream layer that meters the bytes and time of the layer above it.
+     * Sits between websocket::stream and the TLS stream: what crosses it is the compressed,
+     * framed WebSocket traffic, and completions handed up run the WebSocket layer's own code.
+     * Single-threaded use (one strand / io_context thread), like the streams it wraps.
+     */
+    template<class NextLayer>
+    class MeteredStream {
+    public:
+        using next_layer_type = NextLayer;
+        using executor_type = typename NextLayer::executor_type;
+
+        /// Marks a span of WebSocket-layer work (initiating a read / write); nests.
+        class CodecScope {
+        public:
+            explicit CodecScope(MeteredStream &s) noexcept : s_(s) {
+                if (s_.depth_++ == 0) {
+                    s_.start_ = now_();
+                    s_.excluded_ = 0;
+                }
+            }
+
+            ~CodecScope() {
+                if (--s_.depth_ == 0) s_.traffic_.codec_ns += now_() - s_.start_ - s_.excluded_;
+            }
+
+            CodecScope(const CodecScope &) = delete;
+            CodecScope &operator=(const CodecScope &) = delete;
+
+        private:
+            MeteredStream &s_;
+        };
+
+        /// Takes an application callback out of the enclosing CodecScope. Codec work it starts
+        /// itself (e.g. a send from inside a message handler) is measured on its own.
+        class UserScope {
+        public:
+            explicit UserScope(MeteredStream &s) noexcept : s_(s), depth_(s.depth_), t0_(now_()) {
+                s_.depth_ = 0;
+            }
+
+            ~UserScope() {
+                s_.depth_ = depth_;
+                if (depth_ > 0) s_.excluded_ += now_() - t0_;
+            }
+
+            UserScope(const UserScope &) = delete;
+            UserScope &operator=(const UserScope &) = delete;
+
+        private:
+            MeteredStream &s_;
+            int depth_;
+            std::int64_t t0_;
+        };
+
+        template<class... Args>
+        explicit MeteredStream(Args &&... args) : next_(std::forward<Args>(args)...) {
+        }
+
+        executor_type get_executor() noexcept { return next_.get_executor(); }
+
+        next_layer_type &next_layer() noexcept { return next_; }
+        const next_layer_type &next_layer() const noexcept { return next_; }
+
+        WsTraffic &traffic() noexcept { return traffic_; }
+        const WsTraffic &traffic() const noexcept { return traffic_; }
+
+        template<class MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence &buffers) {
+            const std::size_t n = next_.read_some(buffers);
+            traffic_.wire_in += n;
+            return n;
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence &buffers, boost::beast::error_code &ec) {
+            const std::size_t n = next_.read_some(buffers, ec);
+            traffic_.wire_in += n;
+            return n;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence &buffers) {
+            const std::size_t n = next_.write_some(buffers);
+            traffic_.wire_out += n;
+            return n;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence &buffers, boost::beast::error_code &ec) {
+            const std::size_t n = next_.write_some(buffers, ec);
+            traffic_.wire_out += n;
+            return n;
+        }
+
+        template<class MutableBufferSequence, class Token>
+        auto async_read_some(const MutableBufferSequence &buffers, Token &&token) {
+            return boost::asio::async_initiate<Token, void(boost::beast::error_code, std::size_t)>(
+                [this](auto handler, const MutableBufferSequence &b) {
+                    next_.async_read_some(b, Completion<decltype(handler)>{std::move(handler), this, &traffic_.wire_in});
+                }, token, buffers);
+        }
+
+        template<class ConstBufferSequence, class Token>
+        auto async_write_some(const ConstBufferSequence &buffers, Token &&token) {
+            return boost::asio::async_initiate<Token, void(boost::beast::error_code, std::size_t)>(
+                [this](auto handler, const ConstBufferSequence &b) {
+                    next_.async_write_some(b, Completion<decltype(handler)>{std::move(handler), this, &traffic_.wire_out});
+                }, token, buffers);
+        }
+
+    private:
+        static std::int64_t now_() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /// Counts the bytes, then runs the layer above inside a CodecScope. Keeps the wrapped
+        /// handler's executor and allocator so the composed operations above behave as before.
+        template<class Handler>
+        struct Completion {
+            Handler handler;
+            MeteredStream *stream;
+            std::uint64_t *counter;
+
+            using executor_type = boost::asio::associated_executor_t<Handler, typename MeteredStream::executor_type>;
+            using allocator_type = boost::asio::associated_allocator_t<Handler>;
+
+            executor_type get_executor() const noexcept {
+                return boost::asio::get_associated_executor(handler, stream->get_executor());
+            }
+
+            allocator_type get_allocator() const noexcept { return boost::asio::get_associated_allocator(handler); }
+
+            void operator()(boost::beast::error_code ec, std::size_t n) {
+                *counter += n;
+                CodecScope scope(*stream);
+                std::move(handler)(ec, n);
+            }
+        };
+
+        NextLayer next_;
+        WsTraffic traffic_;
+        int depth_{0};
+        std::int64_t start_{0};
+        std::int64_t excluded_{0};
+    };
+
+    /// websocket::stream closes through its next layer; forward to the wrapped stream's teardown.
+    template<class NextLayer>
+    void teardown(boost::beast::role_type role, MeteredStream<NextLayer> &s, boost::beast::error_code &ec) {
+        using boost::beast::websocket::teardown;
+        teardown(role, s.next_layer(), ec);
+    }
+
+    template<class NextLayer, class TeardownHandler>
+    void async_teardown(boost::beast::role_type role, MeteredStream<NextLayer> &s, TeardownHandler &&handler) {
+        using boost::beast::websocket::async_teardown;
+        async_teardown(role, s.next_layer(), std::forward<TeardownHandler>(handler));
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/error.hpp>
+
+namespace md {
+    /**
+     * TCP socket layer that can report the kernel receive time of the data it reads (SO_TIMESTAMPNS, Linux).
+     * Sits under the TLS stream. When timestamps are off, reads forward to the socket unchanged. When they
+     * are on, each read waits for readability and then calls recvmsg(), and the SCM_TIMESTAMPNS of the last
+     * segment it consumed becomes lastRxNs().
+     * - Read from a frame-completion handler, lastRxNs() is the kernel time of the last segment read before
+     *   the frame completed. When one read carries several frames, they share that segment's time.
+     * - Software timestamps taken at the kernel receive path (CLOCK_REALTIME); no NIC support needed.
+     */
+    class RxTimestampSocket {
+    public:
+        using socket_type = boost::asio::ip::tcp::socket;
+        using next_layer_type = socket_type;
+        using lowest_layer_type = socket_type::lowest_layer_type;
+        using executor_type = socket_type::executor_type;
+
+        explicit RxTimestampSocket(boost::asio::io_context &ioc) : sock_(ioc) {
+        }
+
+        executor_type get_executor() noexcept { return sock_.get_executor(); }
+        next_layer_type &next_layer() noexcept { return sock_; }
+        lowest_layer_type &lowest_layer() noexcept { return sock_.lowest_layer(); }
+        const lowest_layer_type &lowest_layer() const noexcept { return sock_.lowest_layer(); }
+
+        /// Turns kernel receive timestamps on / off for the connected socket; call after each connect.
+        /// Returns false (and stays off) when the platform or the socket refuses.
+        bool enableTimestamps(bool on) noexcept;
+
+        [[nodiscard]] bool timestampsEnabled() const noexcept { return enabled_; }
+
+        /// Kernel receive time (ns since epoch) of the last segment read; 0 = off or none seen yet.
+        [[nodiscard]] std::int64_t lastRxNs() const noexcept { return last_rx_ns_; }
+
+        template<class MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence &buffers) { return sock_.read_some(buffers); }
+
+        template<class MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence &buffers, boost::beast::error_code &ec) {
+            return sock_.read_some(buffers, ec);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence &buffers) { return sock_.write_some(buffers); }
+
+        template<class ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence &buffers, boost::beast::error_code &ec) {
+            return sock_.write_some(buffers, ec);
+        }
+
+        template<class MutableBufferSequence, class Token>
+        auto async_read_some(const MutableBufferSequence &buffers, Token &&token) {
+            return boost::asio::async_initiate<Token, void(boost::beast::error_code, std::size_t)>(
+                [this](auto handler, const MutableBufferSequence &b) {
+                    if (!enabled_) {
+                        sock_.async_read_some(b, std::move(handler));
+                        return;
+                    }
+                    sock_.async_wait(socket_type::wait_read, RecvOp<decltype(handler), MutableBufferSequence>{
+                                         std::move(handler), this, b
+                                     });
+                }, token, buffers);
+        }
+
+        template<class ConstBufferSequence, class Token>
+        auto async_write_some(const ConstBufferSequence &buffers, Token &&token) {
+            return sock_.async_write_some(buffers, std::forward<Token>(token));
+        }
+
+    private:
+        static constexpr std::size_t kMaxBuffers = 16;
+
+        /// Non-blocking recvmsg into 'bufs'; records the segment timestamp. would_block when nothing is queued.
+        std::size_t recv_(const boost::asio::mutable_buffer *bufs, std::size_t count, boost::beast::error_code &ec);
+
+        template<class MutableBufferSequence>
+        std::size_t recvInto_(const MutableBufferSequence &buffers, boost::beast::error_code &ec) {
+            std::array<boost::asio::mutable_buffer, kMaxBuffers> bufs;
+            std::size_t count = 0;
+            for (auto it = boost::asio::buffer_sequence_begin(buffers);
+                 it != boost::asio::buffer_sequence_end(buffers) && count < kMaxBuffers; ++it) {
+                const boost::asio::mutable_buffer b(*it);
+                if (b.size() > 0) bufs[count++] = b;
+            }
+            return recv_(bufs.data(), count, ec);
+        }
+
+        /// Readiness -> recvmsg; waits again on a spurious wake-up. Keeps the handler's executor and allocator.
+        template<class Handler, class MutableBufferSequence>
+        struct RecvOp {
+            Handler handler;
+            RxTimestampSocket *self;
+            MutableBufferSequence buffers;
+
+            using executor_type = boost::asio::associated_executor_t<Handler, RxTimestampSocket::executor_type>;
+            using allocator_type = boost::asio::associated_allocator_t<Handler>;
+
+            executor_type get_executor() const noexcept {
+                return boost::asio::get_associated_executor(handler, self->get_executor());
+            }
+
+            allocator_type get_allocator() const noexcept { return boost::asio::get_associated_allocator(handler); }
+
+            void operator()(boost::beast::error_code ec) {
+                std::size_t n = 0;
+                if (!ec) {
+                    n = self->recvInto_(buffers, ec);
+                    if (ec == boost::asio::error::would_block) {
+                        self->sock_.async_wait(socket_type::wait_read, std::move(*this));
+                        return;
+                    }
+                }
+                std::move(handler)(ec, n);
+            }
+        };
+
+        socket_type sock_;
+        bool enabled_{false};
+        std::int64_t last_rx_ns_{0};
+    };
+}
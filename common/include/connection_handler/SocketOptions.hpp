@@ -0,0 +1,34 @@
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <string>
+
+namespace md {
+    /**
+     * Kernel socket options applied to a TCP socket right after connect / accept. One profile is shared
+     * by WsClient, RestClient and brain's WsSession.
+     * - tcp_nodelay is on by default: feed and publish frames are small and latency-bound, and Nagle
+     *   holds them back until the previous segment is ACKed.
+     * - Buffer sizes of 0 keep the kernel default. Setting one disables that direction's autotuning. Because
+     *   it is applied after the handshake, it also does not change the window scale agreed in the SYN.
+     * - busy_poll_us and quickack are Linux only. TCP_QUICKACK is not sticky, so the WebSocket read
+     *   loops re-arm it after every read when enabled.
+     */
+    struct SocketOptions {
+        bool tcp_nodelay{true};
+        int rcvbuf{0}; ///< SO_RCVBUF bytes, 0 = kernel default
+        int sndbuf{0}; ///< SO_SNDBUF bytes, 0 = kernel default
+        int busy_poll_us{0}; ///< SO_BUSY_POLL microseconds, 0 = off (raising it needs CAP_NET_ADMIN)
+        bool quickack{false}; ///< TCP_QUICKACK: ACK immediately instead of delaying
+        int tos{-1}; ///< IP_TOS / IPV6_TCLASS byte (e.g. 0x10 low delay, DSCP << 2), -1 = leave
+    };
+
+    /// Applies 'opts' to an open socket. Never throws; returns the options that failed ("" = all applied).
+    std::string applySocketOptions(boost::asio::ip::tcp::socket &sock, const SocketOptions &opts);
+
+    /// Re-arms TCP_QUICKACK after a read (the kernel clears it). No-op unless opts.quickack.
+    void rearmQuickAck(boost::asio::ip::tcp::socket &sock, const SocketOptions &opts) noexcept;
+
+    std::string describe(const SocketOptions &opts);
+}
@@ -17,9 +17,15 @@
 #include <memory>
 #include <string>
 
+#include "connection_handler/MeteredStream.hpp"
+#include "connection_handler/RxTimestampSocket.hpp"
+#include "connection_handler/SocketOptions.hpp"
+#include "connection_handler/WsDeflate.hpp"
+
 namespace md {
     class WsClient : public std::enable_shared_from_this<WsClient> {
     public:
+        /// Called with the frame in place in the read buffer: the bytes are valid only during the call.
         using RawMessageHandler = std::function<void(const char *, std::size_t)>;
         using CloseHandler = std::function<void()>;
         using OpenHandler = std::function<void()>;
@@ -56,6 +62,25 @@ namespace md {
         // If exceeded, the oldest messages are dropped.
         void set_max_outbox(std::size_t max) { max_outbox_ = max; }
 
+        // permessage-deflate offer for the next connect(); off by default.
+        void set_deflate(const WsDeflateOptions &opts) { deflate_ = opts; }
+
+        // Kernel socket options applied after each TCP connect (TCP_NODELAY on by default).
+        void set_socket_options(const SocketOptions &opts) { sock_opts_ = opts; }
+
+        // Kernel receive timestamps (SO_TIMESTAMPNS, Linux) for the next connect(); off by default.
+        void set_kernel_rx_timestamps(bool enabled) { kernel_rx_ts_ = enabled; }
+
+        // Kernel receive time (ns since epoch) of the last TCP segment read before the current frame
+        // completed; valid inside the raw message handler. 0 when disabled or unavailable.
+        [[nodiscard]] std::int64_t last_rx_kernel_ns() const noexcept {
+            return ws_.next_layer().next_layer().next_layer().lastRxNs();
+        }
+
+        // Byte / codec-time counters of the current connection (reset by connect()).
+        // Read on the io_context thread.
+        [[nodiscard]] const WsTraffic &traffic() const noexcept { return ws_.next_layer().traffic(); }
+
         void connect(std::string host, std::string port, std::string target);
 
         void send_text(std::string text);
@@ -102,9 +127,11 @@ namespace md {
     private:
         using tcp = boost::asio::ip::tcp;
 
-        using websocket_stream =
-        boost::beast::websocket::stream<
-            boost::beast::ssl_stream<tcp::socket> >;
+        using tls_stream = boost::beast::ssl_stream<RxTimestampSocket>;
+        using Meter = MeteredStream<tls_stream>;
+        using websocket_stream = boost::beast::websocket::stream<Meter>;
+
+        tls_stream &tls_() noexcept { return ws_.next_layer().next_layer(); }
 
         boost::asio::io_context &ioc_;
         boost::asio::strand<boost::asio::io_context::executor_type> strand_;
@@ -114,8 +141,7 @@ namespace md {
         websocket_stream ws_;
         tcp::resolver resolver_;
 
-        boost::beast::flat_buffer buffer_;
-        std::string message_; // reused capacity for read payload
+        boost::beast::flat_buffer buffer_; // frames are delivered from here; capacity kept across reads
 
         std::string host_;
         std::string port_;
@@ -136,6 +162,9 @@ namespace md {
         std::chrono::milliseconds ping_interval_{0}; // 0 = disabled
 
         bool tls_verify_peer_{true};
+        WsDeflateOptions deflate_{};
+        SocketOptions sock_opts_{};
+        bool kernel_rx_ts_{false};
 
         CloseHandler on_close_;
         RawMessageHandler on_raw_message_;
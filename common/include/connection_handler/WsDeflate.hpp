@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+
+#include <boost/beast/websocket/option.hpp>
+
+namespace md {
+    /**
+     * permessage-deflate (RFC 7692) settings for one WebSocket link, shared by WsClient and brain's WsSession.
+     * - 'enabled' offers the extension (client) or accepts it (server); it is only used if both ends agree.
+     * - Once negotiated each side decides for its own direction: 'level' 0 sends our frames as stored
+     *   deflate blocks (no compression CPU, a few bytes of overhead), while the peer may still compress.
+     */
+    struct WsDeflateOptions {
+        bool enabled{false};
+        int window_bits{15}; ///< LZ77 window offered for both directions, 9..15 (memory per connection)
+        bool no_context_takeover{false}; ///< reset the compressor per message (less memory, worse ratio)
+        int level{6}; ///< 0..9 for frames we send; 0 = do not compress our direction
+    };
+
+    inline boost::beast::websocket::permessage_deflate toPermessageDeflate(const WsDeflateOptions &o, bool server) {
+        boost::beast::websocket::permessage_deflate pmd;
+        pmd.server_enable = server && o.enabled;
+        pmd.client_enable = !server && o.enabled;
+        pmd.server_max_window_bits = std::clamp(o.window_bits, 9, 15); // zlib rejects 8
+        pmd.client_max_window_bits = pmd.server_max_window_bits;
+        pmd.server_no_context_takeover = o.no_context_takeover;
+        pmd.client_no_context_takeover = o.no_context_takeover;
+        pmd.compLevel = std::clamp(o.level, 0, 9);
+        return pmd;
+    }
+
+    inline std::string describe(const WsDeflateOptions &o) {
+        if (!o.enabled) return "off";
+        return "on window_bits=" + std::to_string(std::clamp(o.window_bits, 9, 15)) +
+               " context_takeover=" + (o.no_context_takeover ? "off" : "on") +
+               " level=" + std::to_string(std::clamp(o.level, 0, 9));
+    }
+}
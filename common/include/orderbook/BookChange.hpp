@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "orderbook/BookLevel.hpp"
+
+namespace md {
+    /**
+     * Compact summary of what one book mutation (or one venue message) changed.
+     * - bboPrice / bboQty: the best bid or best ask moved / only its quantity changed
+     * - shallowest / deepest: range of ranks (0 = top of book, either side) that were written,
+     *   inserted or removed; a rank at or beyond the published depth is a reserve-band change
+     * Consumers that only look at the top (arb scan, top-N persistence) can skip the message when
+     * !bboChanged() or !topChanged(n), which is the common case for deep-book traffic.
+     */
+    struct BookChange {
+        static constexpr std::uint32_t kNoRank = 0xffffffffU;
+
+        bool bboPrice{false};
+        bool bboQty{false};
+        std::uint32_t shallowest{kNoRank};
+        std::uint32_t deepest{kNoRank};
+
+        /// Everything changed (snapshot applied, book reset).
+        [[nodiscard]] static BookChange all() noexcept { return BookChange{true, true, 0, kNoRank - 1}; }
+
+        [[nodiscard]] bool touched() const noexcept { return shallowest != kNoRank; }
+
+        [[nodiscard]] bool bboChanged() const noexcept { return bboPrice || bboQty; }
+
+        /// true if any of the first 'n' ranks of either side changed
+        [[nodiscard]] bool topChanged(std::size_t n) const noexcept { return touched() && shallowest < n; }
+
+        void touch(std::size_t rank) noexcept {
+            const auto r = static_cast<std::uint32_t>(std::min<std::size_t>(rank, kNoRank - 1));
+            shallowest = touched() ? std::min(shallowest, r) : r;
+            deepest = (deepest == kNoRank) ? r : std::max(deepest, r);
+        }
+
+        /// Set the BBO flags from one side's best level before and after the mutation.
+        void compareBest(const BookLevel &before, const BookLevel &after) noexcept {
+            if (before.priceTick != after.priceTick) bboPrice = true;
+            else if (before.quantityLot != after.quantityLot) bboQty = true;
+        }
+
+        BookChange &operator|=(const BookChange &o) noexcept {
+            bboPrice |= o.bboPrice;
+            bboQty |= o.bboQty;
+            if (o.touched()) {
+                touch(o.shallowest);
+                touch(o.deepest);
+            }
+            return *this;
+        }
+    };
+}
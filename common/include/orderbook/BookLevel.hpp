@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Normalized venue level as produced by the adapters (message / DTO form).
+ * Carries the venue's original decimal text next to the scaled integers so that
+ * checksum and persistence code can reproduce it byte-for-byte.
+ * The text is a view, not a copy: into the frame it was scanned from (valid until the next
+ * frame) or into the owning message's TextArena. The book copies it into its LevelTextTable
+ * only when it retains text.
+ */
+struct Level {
+    std::int64_t priceTick;
+    std::int64_t quantityLot;
+
+    std::string_view price;
+    std::string_view quantity;
+
+    bool isEmpty() const { return (quantityLot == 0); }
+};
+
+/**
+ * Hot representation of a level inside the book: 16 bytes, no strings.
+ * Searches and inserts only ever touch these, so a 400-deep side is ~6.4KB.
+ */
+struct BookLevel {
+    std::int64_t priceTick{0};
+    std::int64_t quantityLot{0};
+
+    bool isEmpty() const noexcept { return (quantityLot == 0); }
+};
+
+/**
+ * Original decimal text of a book level (cold path: checksum / persistence).
+ */
+struct LevelText {
+    std::string price;
+    std::string quantity;
+};
+
+enum class Side {
+    BID,
+    ASK
+};
+
+namespace md {
+    /**
+     * Side table mapping priceTick -> original text for the levels currently in one side of the book.
+     * - Only populated when text retention is enabled on the book (see OrderBook::setRetainText).
+     * - Erased nodes are recycled, so steady-state churn does not hit the allocator
+     *   (the strings keep their capacity as well).
+     */
+    class LevelTextTable {
+    public:
+        void assign(std::int64_t priceTick, std::string_view price, std::string_view quantity) {
+            auto it = map_.find(priceTick);
+            if (it == map_.end()) {
+                if (!spare_.empty()) {
+                    auto node = std::move(spare_.back());
+                    spare_.pop_back();
+                    node.key() = priceTick;
+                    it = map_.insert(std::move(node)).position;
+                } else {
+                    it = map_.try_emplace(priceTick).first;
+                }
+            }
+            it->second.price.assign(price);
+            it->second.quantity.assign(quantity);
+        }
+
+        void erase(std::int64_t priceTick) {
+            auto it = map_.find(priceTick);
+            if (it == map_.end()) return;
+            if (spare_.size() < kMaxSpare) {
+                spare_.push_back(map_.extract(it));
+            } else {
+                map_.erase(it);
+            }
+        }
+
+        [[nodiscard]] const LevelText *find(std::int64_t priceTick) const noexcept {
+            const auto it = map_.find(priceTick);
+            return it == map_.end() ? nullptr : &it->second;
+        }
+
+        void clear() {
+            while (!map_.empty() && spare_.size() < kMaxSpare) {
+                spare_.push_back(map_.extract(map_.begin()));
+            }
+            map_.clear();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return map_.size(); }
+
+    private:
+        using Map = std::unordered_map<std::int64_t, LevelText>;
+        static constexpr std::size_t kMaxSpare = 1024;
+
+        Map map_;
+        std::vector<Map::node_type> spare_;
+    };
+
+    /**
+     * Both sides' text tables plus the retention switch; shared by the book implementations.
+     */
+    class BookTextStore {
+    public:
+        void setRetain(bool retain) {
+            retain_ = retain;
+            if (!retain) clear();
+        }
+
+        [[nodiscard]] bool retains() const noexcept { return retain_; }
+
+        template<Side S>
+        void store(const Level &level) {
+            if (retain_) table<S>().assign(level.priceTick, level.price, level.quantity);
+        }
+
+        template<Side S>
+        void drop(std::int64_t priceTick) {
+            if (retain_) table<S>().erase(priceTick);
+        }
+
+        template<Side S>
+        [[nodiscard]] const LevelText *find(std::int64_t priceTick) const noexcept {
+            return (S == Side::BID) ? bids_.find(priceTick) : asks_.find(priceTick);
+        }
+
+        void clear() noexcept {
+            try {
+                bids_.clear();
+                asks_.clear();
+            } catch (...) {
+            }
+        }
+
+        template<Side S>
+        void clear() noexcept {
+            try {
+                table<S>().clear();
+            } catch (...) {
+            }
+        }
+
+    private:
+        template<Side S>
+        LevelTextTable &table() noexcept { return (S == Side::BID) ? bids_ : asks_; }
+
+        bool retain_{false};
+        LevelTextTable bids_;
+        LevelTextTable asks_;
+    };
+
+    /**
+     * One delta entry of a batch: numeric copy for the merge plus the source level for its text.
+     */
+    struct BatchLevel {
+        std::int64_t priceTick;
+        std::int64_t quantityLot;
+        const Level *src;
+    };
+
+    /**
+     * Reusable scratch that turns one side of a venue message into a batch in book order
+     * (bids descending, asks ascending) with one entry per tick.
+     * - sorting is skipped when the venue already sends the side in book order
+     * - for a tick repeated inside the message the last entry wins, like sequential updates
+     */
+    class LevelBatch {
+    public:
+        template<Side S>
+        std::span<const BatchLevel> prepare(std::span<const Level> delta) {
+            entries_.clear();
+            for (const Level &l: delta) entries_.push_back(BatchLevel{l.priceTick, l.quantityLot, &l});
+
+            auto order = [](const BatchLevel &x, const BatchLevel &y) {
+                return (S == Side::BID) ? (x.priceTick > y.priceTick) : (x.priceTick < y.priceTick);
+            };
+            /// std::sort rather than std::stable_sort (which allocates a buffer per call): 'src' points into
+            /// the delta span, so it breaks ties in message order and the dedup below still keeps the last.
+            if (!std::is_sorted(entries_.begin(), entries_.end(), order)) {
+                std::sort(entries_.begin(), entries_.end(), [&order](const BatchLevel &x, const BatchLevel &y) {
+                    return order(x, y) || (x.priceTick == y.priceTick && x.src < y.src);
+                });
+            }
+
+            std::size_t w = 0;
+            for (std::size_t i = 0; i < entries_.size(); ++i) {
+                if (w > 0 && entries_[w - 1].priceTick == entries_[i].priceTick) {
+                    entries_[w - 1] = entries_[i];
+                } else {
+                    entries_[w++] = entries_[i];
+                }
+            }
+            entries_.resize(w);
+            return entries_;
+        }
+
+    private:
+        std::vector<BatchLevel> entries_;
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+#include "orderbook/BookLevel.hpp"
+#include "orderbook/DepthIndex.hpp"
+
+namespace md {
+    /**
+     * Everything a book implementation maintains next to its levels, fed from the same mutation points:
+     * - the text side tables (see BookTextStore)
+     * - the optional cumulative-depth index per side (see DepthIndex)
+     * Implementations call store() for every added/changed level and drop() for every removed one.
+     */
+    class BookShadow {
+    public:
+        void setRetain(bool retain) { text.setRetain(retain); }
+
+        [[nodiscard]] bool retains() const noexcept { return text.retains(); }
+
+        void enableDepthIndex(std::size_t windowTicks) {
+            bidIndex.enable(windowTicks);
+            askIndex.enable(windowTicks);
+        }
+
+        [[nodiscard]] bool depthIndexEnabled() const noexcept { return bidIndex.enabled(); }
+
+        template<Side S>
+        void store(const Level &level) {
+            text.store<S>(level);
+            index<S>().set(toKey<S>(level.priceTick), level.quantityLot);
+        }
+
+        template<Side S>
+        void drop(std::int64_t priceTick) {
+            text.drop<S>(priceTick);
+            index<S>().set(toKey<S>(priceTick), 0);
+        }
+
+        template<Side S>
+        [[nodiscard]] const LevelText *find(std::int64_t priceTick) const noexcept {
+            return text.find<S>(priceTick);
+        }
+
+        void clear() noexcept {
+            text.clear();
+            bidIndex.clear();
+            askIndex.clear();
+        }
+
+        template<Side S>
+        void clear() noexcept {
+            text.clear<S>();
+            index<S>().clear();
+        }
+
+        /**
+         * Cost of taking 'qtyLot' from side S of 'book', best price first (ticks).
+         * The index is rebuilt from the book's levels first if it went stale.
+         */
+        template<Side S, typename Book>
+        [[nodiscard]] FillCost costToFill(const Book &book, std::int64_t qtyLot) const {
+            sync<S>(book);
+            FillCost c = index<S>().costToFill(qtyLot);
+            if constexpr (S == Side::BID) {
+                c.notional = -c.notional;
+                c.worstTick = -c.worstTick;
+            }
+            return c;
+        }
+
+        /// Total quantity on side S of 'book' at prices as good as or better than 'priceTick'.
+        template<Side S, typename Book>
+        [[nodiscard]] std::int64_t qtyWithin(const Book &book, std::int64_t priceTick) const {
+            sync<S>(book);
+            return index<S>().qtyWithin(toKey<S>(priceTick));
+        }
+
+    private:
+        template<Side S>
+        static constexpr std::int64_t toKey(std::int64_t v) noexcept { return (S == Side::BID) ? -v : v; }
+
+        template<Side S>
+        DepthIndex &index() const noexcept { return (S == Side::BID) ? bidIndex : askIndex; }
+
+        template<Side S, typename Book>
+        void sync(const Book &book) const {
+            DepthIndex &ix = index<S>();
+            if (!ix.needsRebuild()) return;
+            ix.rebuild([&book](std::size_t i, std::int64_t &key, std::int64_t &lot) {
+                const BookLevel *l = (S == Side::BID) ? book.bid_ptr(i) : book.ask_ptr(i);
+                if (!l) return false;
+                key = toKey<S>(l->priceTick);
+                lot = l->quantityLot;
+                return true;
+            });
+        }
+
+        BookTextStore text;
+
+        /// Query-side caches: rebuilt lazily from const queries.
+        mutable DepthIndex bidIndex;
+        mutable DepthIndex askIndex;
+    };
+}
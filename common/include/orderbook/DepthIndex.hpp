@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Notes:
+ * - Two Fenwick trees over one book side, indexed by tick offset from a window base:
+ *   lots[] (quantity) and notional[] (quantity * offset), so prefix sums give cumulative size and
+ *   cumulative cost from the best price outwards in O(log W).
+ * - Works in side-normalised key space (key = -priceTick for bids, +priceTick for asks), so offset 0
+ *   is always the best end of the window and "deeper" is always a larger offset.
+ * - The window starts W/8 ticks ahead of the best level. Levels more than ~7W/8 ticks behind it are
+ *   not indexed; a level arriving ahead of the window (or the best drifting past W/2) only marks the
+ *   index stale and it is rebuilt from the book on the next query, so the update path never pays
+ *   for a rebase.
+ */
+namespace md {
+    /**
+     * Result of a cost-to-fill query, in key space (see DepthIndex) or ticks (see OrderBook).
+     */
+    struct FillCost {
+        std::int64_t filledLot{0}; ///< <= requested; less when the indexed side runs out
+        long double notional{0};   ///< sum of fill lot * priceTick over the levels consumed
+        std::int64_t worstTick{0}; ///< price of the last (worst) level touched; 0 if nothing filled
+
+        [[nodiscard]] long double vwapTick() const noexcept {
+            return filledLot ? notional / static_cast<long double>(filledLot) : 0.0L;
+        }
+    };
+
+    class DepthIndex {
+    public:
+        /// Allocates 2 * (W + 1) int64 per side; W = windowTicks rounded up to a power of two (>= 64).
+        void enable(std::size_t windowTicks) {
+            width = static_cast<std::int64_t>(std::bit_ceil(std::max<std::size_t>(windowTicks, 64)));
+            lots.assign(static_cast<std::size_t>(width) + 1, 0);
+            notional.assign(static_cast<std::size_t>(width) + 1, 0);
+            reset();
+        }
+
+        [[nodiscard]] bool enabled() const noexcept { return width != 0; }
+
+        /// Set the quantity at 'key' (0 == level removed).
+        void set(std::int64_t key, std::int64_t lot) noexcept {
+            if (width == 0 || stale) return;
+
+            if (!anchored) {
+                if (lot == 0) return;
+                base = key - width / 8;
+                anchored = true;
+            }
+
+            const std::int64_t off = key - base;
+            if (off < 0) {
+                if (lot != 0) stale = true; // new best ahead of the window
+                return;
+            }
+            if (off >= width) {
+                if (lot == 0) return;
+                if (firstOffset() > width / 2) stale = true; // window drifted away from the touch
+                else untracked = true;                       // deep level, not indexed
+                return;
+            }
+
+            const std::int64_t cur = point(off);
+            if (cur == lot) return;
+            add(off, lot - cur);
+            if (cur == 0) ++count;
+            if (lot == 0 && --count == 0) {
+                /// Empty window: re-anchor on the next level, unless deep levels were skipped
+                /// (then only a rebuild from the book is exact).
+                if (untracked) stale = true;
+                else anchored = false;
+            }
+        }
+
+        void clear() noexcept {
+            if (width == 0) return;
+            std::fill(lots.begin(), lots.end(), 0);
+            std::fill(notional.begin(), notional.end(), 0);
+            reset();
+        }
+
+        [[nodiscard]] bool needsRebuild() const noexcept {
+            return width != 0 && (stale || (count > 0 && firstOffset() > width / 2));
+        }
+
+        /**
+         * Rebuild from the side's levels in book order (best first).
+         * @param levelAt - bool(i, key&, lot&): fills rank i in key space, false past the end
+         */
+        template<typename LevelAt>
+        void rebuild(LevelAt &&levelAt) {
+            clear();
+            std::int64_t key = 0, lot = 0;
+            for (std::size_t i = 0; levelAt(i, key, lot); ++i) set(key, lot);
+        }
+
+        /// Walk from the best key outwards until 'qtyLot' is filled. Notional/worst are in key space.
+        [[nodiscard]] FillCost costToFill(std::int64_t qtyLot) const noexcept {
+            FillCost out;
+            if (width == 0 || count == 0 || qtyLot <= 0) return out;
+
+            std::int64_t pos = 0, rem = qtyLot, offNotional = 0;
+            for (std::int64_t step = width; step > 0; step >>= 1) {
+                const std::int64_t nxt = pos + step;
+                if (nxt <= width && lots[nxt] < rem) {
+                    pos = nxt;
+                    rem -= lots[nxt];
+                    out.filledLot += lots[nxt];
+                    offNotional += notional[nxt];
+                }
+            }
+
+            std::int64_t worstOff = 0;
+            if (pos < width) {
+                /// offset 'pos' holds the level where the cumulative size reaches qtyLot
+                out.filledLot += rem;
+                offNotional += rem * pos;
+                worstOff = pos;
+            } else {
+                worstOff = lowerPrefix(out.filledLot);
+            }
+
+            out.notional = static_cast<long double>(base) * static_cast<long double>(out.filledLot) +
+                           static_cast<long double>(offNotional);
+            out.worstTick = base + worstOff;
+            return out;
+        }
+
+        /// Total quantity at keys <= 'key' (as good as or better than it).
+        [[nodiscard]] std::int64_t qtyWithin(std::int64_t key) const noexcept {
+            if (width == 0 || count == 0) return 0;
+            const std::int64_t off = key - base;
+            if (off < 0) return 0;
+            return prefix(std::min(off, width - 1) + 1, lots);
+        }
+
+    private:
+        void reset() noexcept {
+            base = 0;
+            count = 0;
+            anchored = false;
+            stale = false;
+            untracked = false;
+        }
+
+        /// Fenwick update at 0-based offset.
+        void add(std::int64_t off, std::int64_t dLot) noexcept {
+            const std::int64_t dNotional = dLot * off;
+            for (std::int64_t i = off + 1; i <= width; i += i & -i) {
+                lots[i] += dLot;
+                notional[i] += dNotional;
+            }
+        }
+
+        /// Sum of the first n offsets.
+        static std::int64_t prefix(std::int64_t n, const std::vector<std::int64_t> &tree) noexcept {
+            std::int64_t s = 0;
+            for (; n > 0; n -= n & -n) s += tree[n];
+            return s;
+        }
+
+        [[nodiscard]] std::int64_t point(std::int64_t off) const noexcept {
+            return prefix(off + 1, lots) - prefix(off, lots);
+        }
+
+        /// Smallest 0-based offset whose cumulative size reaches 'target' (target >= 1).
+        [[nodiscard]] std::int64_t lowerPrefix(std::int64_t target) const noexcept {
+            std::int64_t pos = 0;
+            for (std::int64_t step = width; step > 0; step >>= 1) {
+                const std::int64_t nxt = pos + step;
+                if (nxt <= width && lots[nxt] < target) {
+                    pos = nxt;
+                    target -= lots[nxt];
+                }
+            }
+            return pos;
+        }
+
+        [[nodiscard]] std::int64_t firstOffset() const noexcept { return count ? lowerPrefix(1) : width; }
+
+        std::int64_t width{0};
+        std::int64_t base{0};
+        std::int64_t count{0}; ///< non-zero offsets inside the window
+        bool anchored{false};
+        bool stale{false};
+        bool untracked{false};  ///< a level behind the window was skipped since the last rebuild
+        std::vector<std::int64_t> lots;     ///< 1-based Fenwick tree
+        std::vector<std::int64_t> notional; ///< 1-based Fenwick tree of lot * offset
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "orderbook/BookLevel.hpp"
+
+namespace md {
+    /**
+     * Fixed-capacity, vector-like level storage living inline in its owner (no heap allocation).
+     * Implements the subset of std::vector used by BasicSortedOrderBook; the capacity is a compile-time
+     * constant, so a FixedOrderBook<N> is a single object with both sides embedded.
+     * Callers never exceed Capacity (the book keeps at most depth + 1 levels transiently).
+     */
+    template<std::size_t Capacity>
+    class InlineLevels {
+    public:
+        using value_type = BookLevel;
+        using iterator = BookLevel *;
+        using const_iterator = const BookLevel *;
+
+        static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+        [[nodiscard]] std::size_t size() const noexcept { return count; }
+        [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+        iterator begin() noexcept { return levels.data(); }
+        iterator end() noexcept { return levels.data() + count; }
+        const_iterator begin() const noexcept { return levels.data(); }
+        const_iterator end() const noexcept { return levels.data() + count; }
+
+        BookLevel *data() noexcept { return levels.data(); }
+        const BookLevel *data() const noexcept { return levels.data(); }
+
+        BookLevel &operator[](std::size_t i) noexcept { return levels[i]; }
+        const BookLevel &operator[](std::size_t i) const noexcept { return levels[i]; }
+
+        BookLevel &front() noexcept { return levels[0]; }
+        const BookLevel &front() const noexcept { return levels[0]; }
+        BookLevel &back() noexcept { return levels[count - 1]; }
+        const BookLevel &back() const noexcept { return levels[count - 1]; }
+
+        void push_back(const BookLevel &l) noexcept { levels[count++] = l; }
+
+        void pop_back() noexcept { --count; }
+
+        iterator insert(iterator pos, const BookLevel &l) noexcept {
+            std::move_backward(pos, end(), end() + 1);
+            *pos = l;
+            ++count;
+            return pos;
+        }
+
+        iterator erase(iterator pos) noexcept {
+            std::move(pos + 1, end(), pos);
+            --count;
+            return pos;
+        }
+
+        /// Growing leaves the new slots with whatever they held before (callers overwrite them).
+        void resize(std::size_t n) noexcept { count = n; }
+
+        void clear() noexcept { count = 0; }
+
+    private:
+        std::array<BookLevel, Capacity> levels{};
+        std::size_t count{0};
+    };
+}
@@ -0,0 +1,469 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "orderbook/BookChange.hpp"
+#include "orderbook/BookLevel.hpp"
+#include "orderbook/BookShadow.hpp"
+
+/**
+ * Notes:
+ * - Levels inside a window of W ticks around the touch live in a tick-indexed ring (slot = key & (W-1)),
+ *   so an update near the top of the book is a single indexed store plus one occupancy bit.
+ * - Levels that fall behind the window (deep book) go to a small sorted overflow vector, kept worst-first so the
+ *   levels a recentre pushes out of the window are appended at its back.
+ * - Both sides share one implementation by working on a side-normalised key:
+ *   key = -priceTick for bids, +priceTick for asks, so "better" is always the smaller key.
+ */
+namespace md {
+    class LadderOrderBook {
+    public:
+        LadderOrderBook(std::size_t depth, std::size_t windowTicks)
+            : bids(depth, windowTicks, true),
+              asks(depth, windowTicks, false) {
+            if (depth == 0)
+                throw std::invalid_argument("OrderBook: depth must be greater than 0");
+        }
+
+        const BookLevel *bid_ptr(std::size_t i) const noexcept { return bids.at(i); }
+
+        const BookLevel *ask_ptr(std::size_t i) const noexcept { return asks.at(i); }
+
+        const LevelText *bid_text(std::size_t i) const noexcept {
+            const BookLevel *l = bid_ptr(i);
+            return l ? shadow.find<Side::BID>(l->priceTick) : nullptr;
+        }
+
+        const LevelText *ask_text(std::size_t i) const noexcept {
+            const BookLevel *l = ask_ptr(i);
+            return l ? shadow.find<Side::ASK>(l->priceTick) : nullptr;
+        }
+
+        void setRetainText(bool retain) { shadow.setRetain(retain); }
+
+        [[nodiscard]] bool retainsText() const noexcept { return shadow.retains(); }
+
+        void enableDepthIndex(std::size_t windowTicks) { shadow.enableDepthIndex(windowTicks); }
+
+        template<Side S>
+        [[nodiscard]] FillCost cost_to_fill(std::int64_t qtyLot) const { return shadow.costToFill<S>(*this, qtyLot); }
+
+        template<Side S>
+        [[nodiscard]] std::int64_t qty_within(std::int64_t priceTick) const {
+            return shadow.qtyWithin<S>(*this, priceTick);
+        }
+
+        /**
+         * Same semantics as SortedOrderBook::update: existing level -> qty update, new level is kept
+         * only while it belongs to the top-N (the worst level is evicted when the side is full).
+         * Returns the rank written, as SortedOrderBook::update does.
+         */
+        template<Side S>
+        BookChange update(const Level &level) {
+            if (level.isEmpty()) return this->remove<S>(level.priceTick);
+
+            BookChange change;
+            const std::int64_t key = toKey<S>(level.priceTick);
+            std::optional<std::int64_t> evicted;
+            if (!side<S>().set(key, level.quantityLot, evicted)) return change;
+
+            if (evicted) shadow.drop<S>(toKey<S>(*evicted));
+            shadow.store<S>(level);
+            change.touch(side<S>().rankOf(key));
+            return change;
+        }
+
+        template<Side S>
+        BookChange remove(std::int64_t priceTick) {
+            BookChange change;
+            const std::int64_t key = toKey<S>(priceTick);
+            const std::size_t rank = side<S>().rankOf(key);
+            if (side<S>().erase(key)) {
+                shadow.drop<S>(priceTick);
+                change.touch(rank);
+            }
+            return change;
+        }
+
+        /**
+         * Same result as SortedOrderBook::applyBatch (truncation once per batch): removals go first so
+         * they free room before any insert can evict, then inserts/updates are applied best-first.
+         * Ranks are reported as each level is applied (positions in the intermediate book), so the range
+         * can differ slightly from the sorted layout's; a change inside the top-N is never missed.
+         */
+        template<Side S>
+        BookChange applyBatch(std::span<const Level> delta) {
+            if (delta.size() == 1) return update<S>(delta.front());
+
+            BookChange change;
+            const std::span<const BatchLevel> batch = scratch.prepare<S>(delta);
+            for (const BatchLevel &b: batch)
+                if (b.quantityLot == 0) change |= remove<S>(b.priceTick);
+            for (const BatchLevel &b: batch)
+                if (b.quantityLot != 0) change |= update<S>(*b.src);
+            return change;
+        }
+
+        /**
+         * Replace one side with a full snapshot side: the side is cleared and the input is inserted
+         * best-first until depth levels are held (the first insert anchors the window on the touch).
+         */
+        template<Side S>
+        void load(std::span<const Level> levels) {
+            side<S>().clear();
+            shadow.clear<S>();
+            for (const BatchLevel &b: scratch.prepare<S>(levels)) {
+                if (b.quantityLot == 0) continue;
+                update<S>(*b.src);
+                if (side<S>().full()) break;
+            }
+        }
+
+        [[nodiscard]] bool validate() const { return bids.validate() && asks.validate(); }
+
+        void clear() noexcept {
+            bids.clear();
+            asks.clear();
+            shadow.clear();
+        }
+
+        [[nodiscard]] const BookLevel &best_bid() const noexcept { return bids.best(); }
+
+        [[nodiscard]] const BookLevel &best_ask() const noexcept { return asks.best(); }
+
+    private:
+        /// key <-> priceTick is its own inverse on both sides.
+        template<Side S>
+        static constexpr std::int64_t toKey(std::int64_t v) noexcept { return (S == Side::BID) ? -v : v; }
+
+        /**
+         * One side of the ladder, in key space (smaller key = better price).
+         * - ring window covers keys [lo, lo + width); every overflow key is >= lo + width
+         * - the best level is always inside the window (recentred otherwise)
+         */
+        class LadderSide {
+        public:
+            LadderSide(std::size_t depth, std::size_t windowTicks, bool isBid)
+                : depth(depth),
+                  width(static_cast<std::int64_t>(std::bit_ceil(std::max<std::size_t>(windowTicks, 64)))),
+                  mask(width - 1),
+                  isBid(isBid),
+                  qty(static_cast<std::size_t>(width), 0),
+                  occ(static_cast<std::size_t>(width / 64), 0) {
+                /// rank view never outgrows depth, so pointers handed out stay valid until the next mutation
+                view.reserve(depth + 1);
+                overflow.reserve(depth + 1);
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept { return ringCount + overflow.size(); }
+
+            [[nodiscard]] bool full() const noexcept { return size() >= depth; }
+
+            /// Returns false if the level was not taken (side full and key worse than the worst kept level).
+            bool set(std::int64_t key, std::int64_t lot, std::optional<std::int64_t> &evicted) {
+                view.clear();
+
+                if (!anchored || key < lo) recentre(key);
+
+                if (key < lo + width) {
+                    const std::size_t slot = slotOf(key);
+                    if (testBit(slot)) {
+                        qty[slot] = lot;
+                        return true;
+                    }
+                    if (size() >= depth) {
+                        if (key > worstKey()) return false;
+                        evictWorst(evicted);
+                    }
+                    qty[slot] = lot;
+                    setBit(slot);
+                    ++ringCount;
+                    if (worstValid && key > worstRing) worstRing = key;
+                    if (size() == 1 || key < bestKey) bestKey = key;
+                    return true;
+                }
+
+                /// Behind the window: sorted overflow (key descending == better towards the back)
+                auto it = overflowFind(key);
+                if (it != overflow.end() && it->priceTick == key) {
+                    it->quantityLot = lot;
+                    return true;
+                }
+                if (size() >= depth && (overflow.empty() || key > overflow.front().priceTick)) return false;
+
+                overflow.insert(it, BookLevel{key, lot});
+                if (size() > depth) {
+                    evicted = overflow.front().priceTick;
+                    overflow.erase(overflow.begin());
+                }
+                if (size() == 1 || key < bestKey) bestKey = key;
+                return true;
+            }
+
+            bool erase(std::int64_t key) {
+                if (!anchored || key < lo) return false;
+
+                if (key < lo + width) {
+                    const std::size_t slot = slotOf(key);
+                    if (!testBit(slot)) return false;
+                    qty[slot] = 0;
+                    clearBit(slot);
+                    --ringCount;
+                    if (key == worstRing) worstValid = false;
+                } else {
+                    auto it = overflowFind(key);
+                    if (it == overflow.end() || it->priceTick != key) return false;
+                    overflow.erase(it);
+                }
+
+                view.clear();
+                if (size() == 0) return true;
+
+                if (key == bestKey) {
+                    const std::int64_t next = nextOccupied(key + 1, lo + width);
+                    bestKey = (next < lo + width) ? next : overflow.back().priceTick;
+                }
+
+                /// Market drifted away from the centre (or the window emptied): recentre on the touch.
+                if (ringCount == 0 || bestKey >= lo + width - width / 4) recentre(bestKey);
+                return true;
+            }
+
+            [[nodiscard]] const BookLevel *at(std::size_t i) const noexcept {
+                if (i >= size()) return nullptr;
+
+                /// Lazily materialise ranks [0, i] in order; ring levels always rank ahead of overflow.
+                if (view.empty()) viewKey = bestKey;
+                while (view.size() <= i) {
+                    if (view.size() < ringCount) {
+                        const std::int64_t k = nextOccupied(viewKey, lo + width);
+                        view.push_back(BookLevel{toTick(k), qty[slotOf(k)]});
+                        viewKey = k + 1;
+                    } else {
+                        const BookLevel &o = overflow[overflow.size() - 1 - (view.size() - ringCount)];
+                        view.push_back(BookLevel{toTick(o.priceTick), o.quantityLot});
+                    }
+                }
+                return &view[i];
+            }
+
+            /// Number of levels strictly better than 'key' (its rank if present). O(distance / 64) in the ring.
+            [[nodiscard]] std::size_t rankOf(std::int64_t key) const noexcept {
+                if (size() == 0 || key <= bestKey) return 0;
+                if (key < lo + width) return countOccupied(bestKey, key);
+
+                auto it = overflowFind(key);
+                if (it != overflow.end() && it->priceTick == key) ++it;
+                return ringCount + static_cast<std::size_t>(overflow.end() - it);
+            }
+
+            [[nodiscard]] const BookLevel &best() const noexcept {
+                static const BookLevel empty{0, 0};
+                const BookLevel *b = at(0);
+                return b ? *b : empty;
+            }
+
+            [[nodiscard]] bool validate() const {
+                if (size() > depth) return false;
+
+                std::size_t ringSeen = 0;
+                for (std::int64_t k = nextOccupied(lo, lo + width); k < lo + width; k = nextOccupied(k + 1, lo + width)) {
+                    if (qty[slotOf(k)] == 0) return false;
+                    ++ringSeen;
+                }
+                if (ringSeen != ringCount) return false;
+
+                for (std::size_t i = 0; i < overflow.size(); ++i) {
+                    if (overflow[i].priceTick < lo + width || overflow[i].isEmpty()) return false;
+                    if (i > 0 && overflow[i - 1].priceTick <= overflow[i].priceTick) return false;
+                }
+
+                if (size() > 0 && (!at(0) || toTick(bestKey) != at(0)->priceTick)) return false;
+                return true;
+            }
+
+            void clear() noexcept {
+                for (std::size_t w = 0; w < occ.size(); ++w) {
+                    for (std::uint64_t bits = occ[w]; bits != 0; bits &= bits - 1) {
+                        qty[w * 64 + static_cast<std::size_t>(std::countr_zero(bits))] = 0;
+                    }
+                    occ[w] = 0;
+                }
+                ringCount = 0;
+                overflow.clear();
+                view.clear();
+                anchored = false;
+                worstValid = false;
+            }
+
+        private:
+            [[nodiscard]] std::size_t slotOf(std::int64_t key) const noexcept {
+                return static_cast<std::size_t>(key & mask);
+            }
+
+            [[nodiscard]] std::int64_t toTick(std::int64_t key) const noexcept { return isBid ? -key : key; }
+
+            [[nodiscard]] bool testBit(std::size_t slot) const noexcept { return (occ[slot >> 6] >> (slot & 63)) & 1U; }
+            void setBit(std::size_t slot) noexcept { occ[slot >> 6] |= (std::uint64_t{1} << (slot & 63)); }
+            void clearBit(std::size_t slot) noexcept { occ[slot >> 6] &= ~(std::uint64_t{1} << (slot & 63)); }
+
+            /// First occupied key in [from, end), or end.
+            [[nodiscard]] std::int64_t nextOccupied(std::int64_t from, std::int64_t end) const noexcept {
+                std::int64_t k = from;
+                while (k < end) {
+                    const std::size_t slot = slotOf(k);
+                    const std::uint64_t bits = occ[slot >> 6] >> (slot & 63);
+                    if (bits != 0) {
+                        k += std::countr_zero(bits);
+                        return k < end ? k : end;
+                    }
+                    k += 64 - static_cast<std::int64_t>(slot & 63);
+                }
+                return end;
+            }
+
+            /// Occupied keys in [from, end), both inside the window.
+            [[nodiscard]] std::size_t countOccupied(std::int64_t from, std::int64_t end) const noexcept {
+                std::size_t c = 0;
+                for (std::int64_t k = from; k < end;) {
+                    const std::size_t slot = slotOf(k);
+                    const std::int64_t take = std::min<std::int64_t>(64 - static_cast<std::int64_t>(slot & 63), end - k);
+                    std::uint64_t bits = occ[slot >> 6] >> (slot & 63);
+                    if (take < 64) bits &= (std::uint64_t{1} << take) - 1;
+                    c += static_cast<std::size_t>(std::popcount(bits));
+                    k += take;
+                }
+                return c;
+            }
+
+            /// Last occupied key in [begin, from], or begin - 1.
+            [[nodiscard]] std::int64_t prevOccupied(std::int64_t from, std::int64_t begin) const noexcept {
+                std::int64_t k = from;
+                while (k >= begin) {
+                    const std::size_t slot = slotOf(k);
+                    const std::uint64_t bits = occ[slot >> 6] << (63 - (slot & 63));
+                    if (bits != 0) {
+                        k -= std::countl_zero(bits);
+                        return k >= begin ? k : begin - 1;
+                    }
+                    k -= static_cast<std::int64_t>(slot & 63) + 1;
+                }
+                return begin - 1;
+            }
+
+            [[nodiscard]] std::int64_t worstRingKey() noexcept {
+                if (!worstValid) {
+                    worstRing = prevOccupied(lo + width - 1, lo);
+                    worstValid = true;
+                }
+                return worstRing;
+            }
+
+            [[nodiscard]] std::int64_t worstKey() noexcept {
+                return overflow.empty() ? worstRingKey() : overflow.front().priceTick;
+            }
+
+            /// First overflow entry with key <= 'key' (overflow is key descending).
+            [[nodiscard]] std::vector<BookLevel>::iterator overflowFind(std::int64_t key) noexcept {
+                return std::lower_bound(overflow.begin(), overflow.end(), key,
+                                        [](const BookLevel &l, std::int64_t k) { return l.priceTick > k; });
+            }
+
+            [[nodiscard]] std::vector<BookLevel>::const_iterator overflowFind(std::int64_t key) const noexcept {
+                return std::lower_bound(overflow.begin(), overflow.end(), key,
+                                        [](const BookLevel &l, std::int64_t k) { return l.priceTick > k; });
+            }
+
+            void evictWorst(std::optional<std::int64_t> &evicted) {
+                if (!overflow.empty()) {
+                    evicted = overflow.front().priceTick;
+                    overflow.erase(overflow.begin());
+                    return;
+                }
+                const std::int64_t k = worstRingKey();
+                const std::size_t slot = slotOf(k);
+                qty[slot] = 0;
+                clearBit(slot);
+                --ringCount;
+                worstValid = false;
+                evicted = k;
+            }
+
+            /**
+             * Move the window so that 'centre' sits in its middle. Only levels crossing the window edge move:
+             * - window moving to better prices: keys falling off the back are appended, worst first, to the
+             *   back of the overflow (they are all better than anything already there)
+             * - window moving to worse prices: overflow keys now inside the window are popped off its back
+             * The region in front of the touch is empty by construction, so nothing is lost at that edge.
+             */
+            void recentre(std::int64_t centre) {
+                const std::int64_t newLo = centre - width / 2;
+                worstValid = false;
+
+                if (!anchored || size() == 0) {
+                    lo = newLo;
+                    anchored = true;
+                    return;
+                }
+                if (newLo == lo) return;
+
+                if (newLo < lo) {
+                    const std::int64_t from = std::max(newLo + width, lo);
+                    for (std::int64_t k = prevOccupied(lo + width - 1, from); k >= from;
+                         k = prevOccupied(k - 1, from)) {
+                        const std::size_t slot = slotOf(k);
+                        overflow.push_back(BookLevel{k, qty[slot]});
+                        qty[slot] = 0;
+                        clearBit(slot);
+                        --ringCount;
+                    }
+                } else {
+                    while (!overflow.empty() && overflow.back().priceTick < newLo + width) {
+                        const std::size_t slot = slotOf(overflow.back().priceTick);
+                        qty[slot] = overflow.back().quantityLot;
+                        setBit(slot);
+                        ++ringCount;
+                        overflow.pop_back();
+                    }
+                }
+                lo = newLo;
+            }
+
+            std::size_t depth;
+            std::int64_t width;
+            std::int64_t mask;
+            bool isBid;
+
+            std::vector<std::int64_t> qty;   ///< ring of quantityLot indexed by slotOf(key); 0 = empty
+            std::vector<std::uint64_t> occ;  ///< occupancy bitmap over ring slots
+            std::vector<BookLevel> overflow; ///< {key, lot} behind the window, key descending (best at the back)
+
+            std::int64_t lo{0};
+            bool anchored{false};
+            std::size_t ringCount{0};
+            std::int64_t bestKey{0};
+
+            std::int64_t worstRing{0};
+            bool worstValid{false};
+
+            /// rank-ordered cache for bid_ptr/ask_ptr, dropped on every mutation
+            mutable std::vector<BookLevel> view;
+            mutable std::int64_t viewKey{0};
+        };
+
+        template<Side S>
+        LadderSide &side() noexcept { return (S == Side::BID) ? bids : asks; }
+
+        LadderSide bids;
+        LadderSide asks;
+
+        BookShadow shadow;
+        LevelBatch scratch;
+    };
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "orderbook/BookLevel.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MD_LEVEL_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Notes:
+ * - Insertion-point search over one side of a sorted book (bids descending, asks ascending).
+ *   Same result as std::lower_bound with the book's comparator: the index of the first level that
+ *   is not strictly better than the tick.
+ * - Branchless binary steps (cmov) narrow the range to a window of kWindow levels, then the window
+ *   is counted with SIMD compares: the answer is "window start + number of better levels in it".
+ *   No data-dependent branch is left for the predictor to miss.
+ * - Ticks are interleaved with quantities (16-byte BookLevel), so the SIMD path de-interleaves with
+ *   unpacklo: AVX2 compares 4 ticks per instruction, the SSE2 fallback 2.
+ * - AVX2 is picked at runtime (cpuid, once per process); binaries still run on SSE2-only hosts.
+ */
+namespace md::level_search {
+    /// Levels left for the linear SIMD count after the binary steps.
+    inline constexpr std::size_t kWindow = 16;
+
+    template<Side S>
+    inline std::size_t countBetterScalar(const BookLevel *p, std::size_t n, std::int64_t tick) noexcept {
+        std::size_t c = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            c += (S == Side::BID) ? (p[i].priceTick > tick) : (p[i].priceTick < tick);
+        return c;
+    }
+
+#ifdef MD_LEVEL_SEARCH_X86
+    /// Signed 64-bit a > b on SSE2 (pcmpgtq is SSE4.2). Valid for any inputs: when the high dwords
+    /// are equal |a - b| < 2^32, so the high dword of (b - a) is all ones exactly when a > b.
+    inline __m128i cmpgt64Sse2(__m128i a, __m128i b) noexcept {
+        __m128i r = _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_sub_epi64(b, a));
+        r = _mm_or_si128(r, _mm_cmpgt_epi32(a, b));
+        return _mm_shuffle_epi32(r, _MM_SHUFFLE(3, 3, 1, 1));
+    }
+
+    template<Side S>
+    inline std::size_t countBetterSse2(const BookLevel *p, std::size_t n, std::int64_t tick) noexcept {
+        const __m128i t = _mm_set1_epi64x(tick);
+        std::size_t c = 0, i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 1));
+            const __m128i ticks = _mm_unpacklo_epi64(a, b);
+            const __m128i gt = (S == Side::BID) ? cmpgt64Sse2(ticks, t) : cmpgt64Sse2(t, ticks);
+            c += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(gt)))));
+        }
+        return c + countBetterScalar<S>(p + i, n - i, tick);
+    }
+
+    template<Side S>
+    __attribute__((target("avx2,popcnt")))
+    inline std::size_t countBetterAvx2(const BookLevel *p, std::size_t n, std::int64_t tick) noexcept {
+        const __m256i t = _mm256_set1_epi64x(tick);
+        std::size_t c = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            /// {t0,q0,t1,q1} / {t2,q2,t3,q3} -> {t0,t2,t1,t3}: lane order is irrelevant for a count
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 2));
+            const __m256i ticks = _mm256_unpacklo_epi64(a, b);
+            const __m256i gt = (S == Side::BID) ? _mm256_cmpgt_epi64(ticks, t) : _mm256_cmpgt_epi64(t, ticks);
+            c += static_cast<std::size_t>(__builtin_popcount(
+                static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(gt)))));
+        }
+        return c + countBetterSse2<S>(p + i, n - i, tick);
+    }
+
+    inline const bool kHasAvx2 = [] {
+        __builtin_cpu_init(); // may run before libgcc's own cpu init during static initialisation
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    }();
+#endif
+
+    /// Number of levels in [p, p + n) strictly better than 'tick' (the whole range must be sorted).
+    template<Side S>
+    inline std::size_t countBetter(const BookLevel *p, std::size_t n, std::int64_t tick) noexcept {
+#ifdef MD_LEVEL_SEARCH_X86
+        if (kHasAvx2) return countBetterAvx2<S>(p, n, tick);
+        return countBetterSse2<S>(p, n, tick);
+#else
+        return countBetterScalar<S>(p, n, tick);
+#endif
+    }
+
+    /**
+     * Index of the first level in [p, p + n) that is not strictly better than 'tick'
+     * (drop-in for std::lower_bound with the side's comparator).
+     */
+    template<Side S>
+    inline std::size_t lowerBound(const BookLevel *p, std::size_t n, std::int64_t tick) noexcept {
+        std::size_t first = 0;
+        while (n > kWindow) {
+            const std::size_t half = n / 2;
+            const std::int64_t mid = p[first + half].priceTick;
+            const bool better = (S == Side::BID) ? (mid > tick) : (mid < tick);
+            first = better ? first + half : first;
+            n -= half;
+        }
+        return first + countBetter<S>(p + first, n, tick);
+    }
+}
@@ -1,207 +1,238 @@
 #pragma once
 
-#include <vector>
-#include <algorithm>
 #include <cstdint>
-#include <stdexcept>
-#include <string>
-
-struct Level {
-    std::int64_t priceTick;
-    std::int64_t quantityLot;
-
-    std::string price;
-    std::string quantity;
-
-    bool isEmpty() const { return (quantityLot == 0); }
-};
-
-enum class Side {
-    BID,
-    ASK
-};
-
-/**
- * Notes:
- * - To confirm empirically, compile with optimizations (-O2/-O3) and check the emitted assembly (e.g., Compiler Explorer).
- *   It should show two separate instantiations where the container address is fixed.
- * - 'lower_bound' does a binary search O(log(N) and returns the insertion point.
- * - Check which is faster in this case, 'lower_bound' or 'find_if'
- * - Both above needs already sorted lists !!!
- */
+#include <span>
+#include <string_view>
+#include <variant>
+
+#include "orderbook/BookChange.hpp"
+#include "orderbook/BookLevel.hpp"
+#include "orderbook/SortedOrderBook.hpp"
+#include "orderbook/LadderOrderBook.hpp"
+#include "utils/Log.hpp"
+
 namespace md {
+    /**
+     * Storage layout behind md::OrderBook, chosen once at construction.
+     * - Sorted: contiguous sorted vectors, binary search + memmove (compact, best for shallow books)
+     * - Ladder: tick-indexed ring around the touch, O(1) updates near the top (best for deep, busy books)
+     */
+    enum class BookKind : std::uint8_t { Sorted, Ladder };
+
+    inline const char *to_string(BookKind k) noexcept {
+        switch (k) {
+            case BookKind::Sorted: return "sorted";
+            case BookKind::Ladder: return "ladder";
+            default: return "UNKNOWN";
+        }
+    }
+
+    inline bool parse_book_kind(std::string_view s, BookKind &out) noexcept {
+        if (s == "sorted") {
+            out = BookKind::Sorted;
+            return true;
+        }
+        if (s == "ladder") {
+            out = BookKind::Ladder;
+            return true;
+        }
+        return false;
+    }
+
+    struct BookOptions {
+        BookKind kind{BookKind::Sorted};
+        std::size_t ladder_ticks{8192}; ///< Ladder only: ring width in ticks (rounded up to a power of two)
+
+        /// Levels kept beyond the published depth. They are never exposed through bid_ptr/ask_ptr,
+        /// but when cancels thin the top they slide up into the published range instead of leaving
+        /// the book short until the next snapshot. Costs reserve_levels * 16 bytes per side.
+        std::size_t reserve_levels{0};
+
+        /// Window (ticks) of the cumulative-depth index behind cost_to_fill / qty_within; 0 = off.
+        /// Costs 2 * 16 bytes per tick per side. Levels more than ~7/8 of it behind the touch are not indexed.
+        std::size_t depth_index_ticks{0};
+    };
+
+    /**
+     * Two-sided bounded order book. Thin facade over the implementation selected by BookOptions;
+     * every implementation exposes the same API and the same top-N semantics.
+     * - The implementation holds depth + reserve_levels per side; only the first 'depth' are
+     *   published (bid_ptr/ask_ptr/bid_text/ask_text), the rest is the reserve band.
+     * - Sorted with a published depth of 20 / 50 / 400 and a reserve band of at most depth / 2 uses the
+     *   inline FixedOrderBook<N> instantiation, anything else the vector-backed SortedOrderBook.
+     */
     class OrderBook {
     public:
-        explicit OrderBook(std::size_t depth) : depth(depth) {
-            if (depth == 0)
-                throw std::invalid_argument("OrderBook: depth must be greater than 0");
+        explicit OrderBook(std::size_t depth, const BookOptions &opts = {})
+            : impl(makeImpl(depth, opts)), published(depth), bookKind(opts.kind) {
+            if (opts.depth_index_ticks > 0)
+                std::visit([&opts](auto &b) { b.enableDepthIndex(opts.depth_index_ticks); }, impl);
+        }
+
+        const BookLevel *bid_ptr(std::size_t i) const noexcept {
+            if (i >= published) return nullptr;
+            return std::visit([i](const auto &b) { return b.bid_ptr(i); }, impl);
+        }
+
+        const BookLevel *ask_ptr(std::size_t i) const noexcept {
+            if (i >= published) return nullptr;
+            return std::visit([i](const auto &b) { return b.ask_ptr(i); }, impl);
+        }
 
-            /// For both vector, (depth + 1) space alocated. The plus 1 is needed to not have any reallocation,
-            /// when the update of the Order Book exceeds the depth by 1 if it full and we have an update to it.
-            /// The update first insert and then pop_back,
-            /// so for a small fraction of time, we exceeds depth, and that would result reallocation. (See Option C. at update())
-            bids.reserve(depth + 1);
-            asks.reserve(depth + 1);
+        /**
+         * Original venue text of the level at depth i, or nullptr if out of range,
+         * empty, or text retention is disabled.
+         */
+        const LevelText *bid_text(std::size_t i) const noexcept {
+            if (i >= published) return nullptr;
+            return std::visit([i](const auto &b) { return b.bid_text(i); }, impl);
         }
 
-        const Level *bid_ptr(std::size_t i) const noexcept {
-            if (i >= bids.size()) return nullptr;
-            if (bids[i].isEmpty()) return nullptr;
-            return &bids[i];
+        const LevelText *ask_text(std::size_t i) const noexcept {
+            if (i >= published) return nullptr;
+            return std::visit([i](const auto &b) { return b.ask_text(i); }, impl);
         }
 
-        const Level *ask_ptr(std::size_t i) const noexcept {
-            if (i >= asks.size()) return nullptr;
-            if (asks[i].isEmpty()) return nullptr;
-            return &asks[i];
+        /**
+         * Keep the venue's decimal text for every level in the book (needed by checksum and
+         * persistence). Off by default: a book that is only read numerically (e.g. brain)
+         * never touches the side table.
+         */
+        void setRetainText(bool retain) {
+            std::visit([retain](auto &b) { b.setRetainText(retain); }, impl);
         }
 
+        [[nodiscard]] bool retainsText() const noexcept {
+            return std::visit([](const auto &b) { return b.retainsText(); }, impl);
+        }
 
         /**
          * 'update' handes the incoming updates to the order book from the exchange
          * @tparam S - side of the orderbook (ask or bid)
          * @param level - the update coming from the exchange
+         * @return what changed: BBO flags and the rank touched (see BookChange)
          */
         template<Side S>
-        void update(const Level &level) {
-            if (level.isEmpty()) {
-                this->remove<S>(level.priceTick);
-                return;
-            }
-
-            std::vector<Level> &vec = (S == Side::BID) ? bids : asks;
-            std::vector<Level>::iterator it = vec.begin();
-            const std::int64_t updateTick = level.priceTick;
-
-            if constexpr (S == Side::BID) {
-                it = std::lower_bound(vec.begin(), vec.end(), updateTick,
-                                      [](const Level &obLevel, std::int64_t _updateTick) {
-                                          /// 'it' becomes the first position where ob.priceTick > tick is false
-                                          return obLevel.priceTick > _updateTick;
-                                      });
-            } else {
-                it = std::lower_bound(vec.begin(), vec.end(), updateTick,
-                                      [](const Level &obLevel, std::int64_t _updateTick) {
-                                          return obLevel.priceTick < _updateTick;
-                                      });
-            }
-
-            /// Option A.: The item is in the order book, just the quantity of it updates.
-            if (it != vec.end() && it->priceTick == updateTick) {
-                it->quantityLot = level.quantityLot;
-                return;
-            }
-
-            /// Option B.: If we have room, insert anywhere (including end)
-            if (vec.size() < depth) {
-                vec.insert(it, level);
-                return;
-            }
-
-            /// Option C.: insert only if it improves top-N (i.e., not at end)
-            if (it != vec.end()) {
-                vec.insert(it, level);
-                vec.pop_back(); // drops last element, since depth have to be ensured
-            }
+        BookChange update(const Level &level) {
+            return mutate<S>([&level](auto &b) { return b.template update<S>(level); });
         }
 
         /**
          * 'remove' erase the level which got quantity=0 update
-         * std::find_if does a linear scan - O(n)
-         * std::lower_bound does a binary search - O(log(n))
          */
         template<Side S>
-        void remove(std::int64_t priceTick) {
-            std::vector<Level> &vec = S == Side::BID ? bids : asks; // resolved at compile time
-            std::vector<Level>::iterator it = vec.begin();
-
-            if constexpr (S == Side::BID) {
-                it = std::lower_bound(vec.begin(), vec.end(), priceTick,
-                                      [](const Level &obLevel, std::int64_t _priceTick) {
-                                          return obLevel.priceTick > _priceTick;
-                                      });
-            } else {
-                it = std::lower_bound(vec.begin(), vec.end(), priceTick,
-                                      [](const Level &obLevel, std::int64_t _priceTick) {
-                                          return obLevel.priceTick < _priceTick;
-                                      });
-            }
-
-            if (it != vec.end() && it->priceTick == priceTick) {
-                vec.erase(it);
-            }
+        BookChange remove(std::int64_t priceTick) {
+            return mutate<S>([priceTick](auto &b) { return b.template remove<S>(priceTick); });
         }
 
         /**
- * Check price level uniqueness and sortedness
- */
-        [[nodiscard]] bool validate() const {
-            // 1) Depth sanity
-            if (bids.size() > depth) return false;
-            if (asks.size() > depth) return false;
-
-            // 2) Sortedness + uniqueness:
-            // bids must be strictly decreasing: bids[i-1].priceTick > bids[i].priceTick
-            for (std::size_t i = 1; i < bids.size(); ++i) {
-                if (bids[i - 1].priceTick <= bids[i].priceTick) {
-                    return false; // not sorted DESC or duplicate tick
-                }
-            }
-
-            // asks must be strictly increasing: asks[i-1].priceTick < asks[i].priceTick
-            for (std::size_t i = 1; i < asks.size(); ++i) {
-                if (asks[i - 1].priceTick >= asks[i].priceTick) {
-                    return false; // not sorted ASC or duplicate tick
-                }
-            }
-
-            // 3) Reject empty levels lingering in book if there can be any
-            for (const Level &l: bids) if (l.isEmpty()) return false;
-            for (const Level &l: asks) if (l.isEmpty()) return false;
+         * 'applyBatch' applies every level of one side of a venue message at once
+         * (single sort + linear merge on the sorted layout). Truncation to depth is applied
+         * once for the whole batch.
+         */
+        template<Side S>
+        BookChange applyBatch(std::span<const Level> delta) {
+            return mutate<S>([delta](auto &b) { return b.template applyBatch<S>(delta); });
+        }
 
-            return true;
+        /**
+         * 'load' replaces one side with a snapshot side in one shot: zero-qty levels are skipped and
+         * the result is truncated to depth. Input already in book order is taken in a single pass.
+         */
+        template<Side S>
+        void load(std::span<const Level> levels) {
+            std::visit([levels](auto &b) { b.template load<S>(levels); }, impl);
         }
 
         /**
-         * Clears the entire book.
-         * 
-         * - All levels on both sides are reset to empty (Level{}).
-         * - Depth and vector sizes are preserved: bids_.size() == asks_.size() == depth_.
+         * Check depth, price level uniqueness and sortedness
          */
+        [[nodiscard]] bool validate() const {
+            return std::visit([](const auto &b) { return b.validate(); }, impl);
+        }
+
         void clear() noexcept {
-            bids.clear();
-            asks.clear();
+            std::visit([](auto &b) { b.clear(); }, impl);
         }
 
         /**
-         * Returns the top-of-book bid level (index 0).
+         * Returns the top-of-book bid level (index 0), or an empty level (priceTick == 0).
          */
-        [[nodiscard]] const Level &best_bid() const noexcept {
-            static const Level empty{0, 0, "", ""};
-            if (bids.empty()) return empty;
-            return bids.front();
+        [[nodiscard]] const BookLevel &best_bid() const noexcept {
+            return std::visit([](const auto &b) -> const BookLevel & { return b.best_bid(); }, impl);
         }
 
         /**
-         * Returns the top-of-book ask level (index 0).
+         * Returns the top-of-book ask level (index 0), or an empty level (priceTick == 0).
          */
-        [[nodiscard]] const Level &best_ask() const noexcept {
-            static const Level empty{0, 0, "", ""};
-            if (asks.empty()) return empty;
-            return asks.front();
+        [[nodiscard]] const BookLevel &best_ask() const noexcept {
+            return std::visit([](const auto &b) -> const BookLevel & { return b.best_ask(); }, impl);
         }
 
-    private:
-        std::size_t depth;
-
         /**
-         * sorted descending by priceTick
+         * Cost of taking 'qtyLot' from side S, best price first: cost_to_fill<Side::ASK>(q) is a buy of q,
+         * cost_to_fill<Side::BID>(q) a sell. O(log W) on the depth index (BookOptions::depth_index_ticks);
+         * covers the reserve band too. Returns an empty FillCost when the index is off.
          */
-        std::vector<Level> bids;
+        template<Side S>
+        [[nodiscard]] FillCost cost_to_fill(std::int64_t qtyLot) const {
+            return std::visit([qtyLot](const auto &b) { return b.template cost_to_fill<S>(qtyLot); }, impl);
+        }
 
         /**
-         * sorted ascending by priceTick
+         * Total quantity on side S at prices as good as or better than 'priceTick' (O(log W), 0 when the index is off).
          */
-        std::vector<Level> asks;
+        template<Side S>
+        [[nodiscard]] std::int64_t qty_within(std::int64_t priceTick) const {
+            return std::visit([priceTick](const auto &b) { return b.template qty_within<S>(priceTick); }, impl);
+        }
+
+        [[nodiscard]] BookKind kind() const noexcept { return bookKind; }
+
+        /// Published depth (levels reachable through bid_ptr/ask_ptr); the reserve band is not included.
+        [[nodiscard]] std::size_t depth() const noexcept { return published; }
+
+    private:
+        /// Run one side mutation; when rank 0 was touched, fill the BBO flags from that side's best level around it.
+        template<Side S, typename Fn>
+        BookChange mutate(Fn &&fn) {
+            return std::visit([&fn](auto &b) {
+                const BookLevel before = (S == Side::BID) ? b.best_bid() : b.best_ask();
+                BookChange change = fn(b);
+                if (change.shallowest == 0) change.compareBest(before, (S == Side::BID) ? b.best_bid() : b.best_ask());
+                return change;
+            }, impl);
+        }
+
+        using Impl = std::variant<SortedOrderBook,
+            FixedOrderBook<20>,
+            FixedOrderBook<50>,
+            FixedOrderBook<400>,
+            LadderOrderBook>;
+
+        /// Picked by published depth; every implementation is sized for depth + reserve band per side.
+        static Impl makeImpl(std::size_t depth, const BookOptions &opts) {
+            const std::size_t levels = depth + opts.reserve_levels;
+            if (opts.kind == BookKind::Ladder)
+                return Impl{std::in_place_type<LadderOrderBook>, levels, opts.ladder_ticks};
+
+            const bool fitsInline = opts.reserve_levels <= depth / 2;
+            if (fitsInline) {
+                switch (depth) {
+                    case 20: return Impl{std::in_place_type<FixedOrderBook<20>>, levels};
+                    case 50: return Impl{std::in_place_type<FixedOrderBook<50>>, levels};
+                    case 400: return Impl{std::in_place_type<FixedOrderBook<400>>, levels};
+                    default: break;
+                }
+            } else if (depth == 20 || depth == 50 || depth == 400) {
+                spdlog::warn("[BOOK] reserve_levels={} exceeds the inline capacity for depth={} (max {}); "
+                             "using the heap-backed sorted book", opts.reserve_levels, depth, depth / 2);
+            }
+            return Impl{std::in_place_type<SortedOrderBook>, levels};
+        }
+
+        Impl impl;
+        std::size_t published;
+        BookKind bookKind;
     };
 }
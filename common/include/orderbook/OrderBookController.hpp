@@ -2,51 +2,75 @@
 
 #include <vector>
 #include <deque>
+#include <memory>
 #include "OrderBook.hpp"
+#include "PublishedBookView.hpp"
 #include "utils/CheckSumUtils.hpp"
+#include "utils/IncrementalChecksum.hpp"
+#include "utils/TextArena.hpp"
 
 struct GenericIncrementalFormat {
     std::uint64_t first_seq{0};
     std::uint64_t last_seq{0};
     std::uint64_t prev_last{0};
     std::int64_t ts_recv_ns{0}; // local receive timestamp at ingestion point
+    std::int64_t ts_recv_kernel_ns{0}; // kernel receive time of the frame's last TCP segment, 0 = not captured
 
     std::int64_t checksum{0};
 
     std::vector<Level> bids;
     std::vector<Level> asks;
+    md::TextArena text; ///< backs level text that does not point into the source frame
 
     void reset() noexcept {
         first_seq = last_seq = prev_last = 0;
         ts_recv_ns = 0;
+        ts_recv_kernel_ns = 0;
         checksum = 0;
         bids.clear();
         asks.clear();
+        text.clear();
+    }
+
+    /// Copy the level text into 'text' so the message outlives the frame it was scanned from
+    /// (buffered until a snapshot arrives).
+    void ownText() {
+        for (auto *side: {&bids, &asks}) {
+            for (Level &l: *side) {
+                l.price = text.store(l.price);
+                l.quantity = text.store(l.quantity);
+            }
+        }
     }
 };
 
 struct GenericSnapshotFormat {
     std::uint64_t lastUpdateId{0};
     std::int64_t ts_recv_ns{0}; // local receive timestamp at ingestion point
+    std::int64_t ts_recv_kernel_ns{0}; // kernel receive time of the frame's last TCP segment, 0 = not captured
 
     std::int64_t checksum{0};
 
     std::vector<Level> bids;
     std::vector<Level> asks;
+    md::TextArena text; ///< backs level text that does not point into the source frame
 
     void reset() noexcept {
         lastUpdateId = 0;
         ts_recv_ns = 0;
+        ts_recv_kernel_ns = 0;
         checksum = 0;
         bids.clear();
         asks.clear();
+        text.clear();
     }
 };
 
 namespace md {
     class OrderBookController {
     public:
-        explicit OrderBookController(const std::size_t depth) : book_{depth} {
+        explicit OrderBookController(const std::size_t depth, const BookOptions &opts = {})
+            : book_{depth, opts} {
         }
 
         ~OrderBookController() = default;
@@ -56,6 +80,13 @@ namespace md {
             checksum_topN_ = topN;
         }
 
+        /// Validate with an InterleavedCrc32Tracker (checkInterleavedCRC32 format, maintained from
+        /// the ranks each update touched) instead of calling checksum_fn on the whole top-N.
+        /// Only meaningful when the configured checksum_fn is checkInterleavedCRC32.
+        void setIncrementalChecksum(bool on) {
+            crc_tracker_ = on ? std::make_unique<InterleavedCrc32Tracker>() : nullptr;
+        }
+
         /// In some venues (e.g. KuCoin) sequence numbers may jump when snapshot is
         /// partial; enabling this flag instructs the controller to tolerate gaps
         /// instead of forcing a resync.  Defaults to false (strict continuity).
@@ -74,6 +105,22 @@ namespace md {
         /// if no checksum_fn is configured.  Default false.
         void setRequireChecksum(bool require) noexcept { require_checksum_ = require; }
 
+        /// Keep the venue's original price/quantity text for levels in the book.
+        /// Required by checksum validation and by sinks that serialize book levels;
+        /// numeric-only consumers leave it off and never touch the text side table.
+        void setRetainLevelText(bool retain) { book_.setRetainText(retain); }
+
+        /// Publish a seqlock-protected copy of the top-N levels after every applied snapshot /
+        /// incremental and on reset, readable wait-free from other threads (see PublishedBookView).
+        /// Off by default; 0 turns it off again. Not thread-safe itself: call before feeding data.
+        void enablePublishedView(std::size_t topN) {
+            view_ = topN > 0 ? std::make_unique<PublishedBookView>(topN) : nullptr;
+            publishView_();
+        }
+
+        /// nullptr unless enablePublishedView() was called. Safe to hand to other threads.
+        [[nodiscard]] const PublishedBookView *publishedView() const noexcept { return view_.get(); }
+
         enum class BaselineKind : std::uint8_t { RestAnchored, WsAuthoritative };
 
         enum class Action {
@@ -96,14 +143,20 @@ namespace md {
         /**
          * 'onIncrement' process the incoming incremental update message from the exchange
          * @param msg - incremental update message
+         * @param change - optional: what the message did to the book (both sides merged). Untouched
+         *                 (default BookChange) when the message was buffered/ignored, BookChange::all()
+         *                 when it led to a reset
          */
-        Action onIncrement(const GenericIncrementalFormat &msg);
+        Action onIncrement(const GenericIncrementalFormat &msg, BookChange *change = nullptr);
 
         void resetBook() {
             book_.clear();
+            if (crc_tracker_) crc_tracker_->invalidate();
+            last_change_ = BookChange::all();
             state_ = BookSyncState::WaitingSnapshot;
             last_seq_ = 0;
             expected_seq_ = 0;
+            publishView_();
         }
 
         [[nodiscard]] const OrderBook &book() const noexcept { return book_; }
@@ -153,11 +206,22 @@ namespace md {
         bool has_checksum_{false};    ///< venue declares it provides checksums
         bool require_checksum_{false}; ///< user opted in to strict checksum enforcement
 
-        bool validateChecksum(std::int64_t expected) const noexcept {
-            if (!checksum_fn_) return true;
-            return checksum_fn_(book_, expected, checksum_topN_);
-        }
+        std::unique_ptr<InterleavedCrc32Tracker> crc_tracker_; ///< incremental mode (optional)
+
+        bool validateChecksum(std::int64_t expected) noexcept;
+
+        Action processIncrement_(const GenericIncrementalFormat &msg);
 
         void applyIncrementUpdate(const GenericIncrementalFormat &upd);
+
+        /// Change summary of the message being processed (see onIncrement)
+        BookChange last_change_;
+
+        // Cross-thread top-N view (optional)
+        std::unique_ptr<PublishedBookView> view_;
+
+        void publishView_() noexcept {
+            if (view_) view_->publish(book_, last_seq_, isSynced());
+        }
     };
 }
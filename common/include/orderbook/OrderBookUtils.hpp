@@ -1,11 +1,16 @@
 #pragma once
 
+#include <bit>
 #include <charconv>
 #include <cstdint>
+#include <cstring>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 
+#include "BookLevel.hpp"
+
 namespace md {
 
 /// Parse a decimal string into integer ticks by scaling in integer arithmetic.
@@ -17,7 +22,10 @@ namespace md {
 /// (price < 9e14 at scale=100), which covers all foreseeable crypto prices.
 ///
 /// Throws std::invalid_argument on malformed input.
-inline std::int64_t parseDecimalToScaled(std::string_view s, std::int64_t scale) {
+///
+/// Reference implementation, one character at a time; parseDecimalToScaled() only
+/// falls back to it for input the SWAR path does not take.
+inline std::int64_t parseDecimalToScaledScalar(std::string_view s, std::int64_t scale) {
     if (s.empty()) throw std::invalid_argument("parseDecimalToScaled: empty string");
 
     bool negative = false;
@@ -60,6 +68,151 @@ inline std::int64_t parseDecimalToScaled(std::string_view s, std::int64_t scale)
     return negative ? -result : result;
 }
 
+namespace detail {
+    constexpr std::uint64_t kAsciiZeros = 0x3030303030303030ULL;
+
+    /// Low 'n' bytes set, n <= 8.
+    constexpr std::uint64_t byteMask(std::size_t n) noexcept { return n >= 8 ? ~0ULL : (1ULL << (8 * n)) - 1; }
+
+    template<typename T>
+    T loadUnaligned(const char *p) noexcept {
+        T v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    /// First min(n, 16) bytes at 'p' as two little-endian lanes (first character in the lowest
+    /// byte of 'lo'), zero above n. Reads only [p, p + n): short tails use overlapping loads.
+    inline void loadUpTo16(const char *p, std::size_t n, std::uint64_t &lo, std::uint64_t &hi) noexcept {
+        using std::uint32_t, std::uint64_t;
+        hi = 0;
+        if (n >= 8) { // 'hi' from a load ending at the last byte, shifted down; zero for n == 8
+            lo = loadUnaligned<uint64_t>(p);
+            hi = (loadUnaligned<uint64_t>(p + n - 8) >> ((8 * (16 - n)) & 63)) & (0 - uint64_t{n > 8});
+        } else if (n >= 4) {
+            lo = loadUnaligned<uint32_t>(p) | (uint64_t{loadUnaligned<uint32_t>(p + n - 4)} << (8 * (n - 4)));
+        } else { // 1..3 bytes: first, middle, last (overlapping for n < 3)
+            const auto byte = [p](std::size_t i) { return uint64_t{static_cast<unsigned char>(p[i])} << (8 * i); };
+            lo = byte(0) | byte(n / 2) | byte(n - 1);
+        }
+    }
+
+    /// Index of the lowest zero byte of 'x', 8 if none (exact for the lowest one).
+    constexpr std::size_t firstZeroByte(std::uint64_t x) noexcept {
+        const std::uint64_t t = (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+        return static_cast<std::size_t>(std::countr_zero(t)) / 8;
+    }
+
+    /// The low 'n' bytes of 'chunk' as an 8-digit string right-aligned behind '0's (n <= 8).
+    constexpr std::uint64_t rightAlignDigits(std::uint64_t chunk, std::size_t n) noexcept {
+        const std::uint64_t aligned = (chunk << ((8 * (8 - n)) & 63)) | (kAsciiZeros & byteMask(8 - n));
+        return n ? aligned : kAsciiZeros; // select, not a branch: n varies field to field
+    }
+
+    /// 8 ASCII bytes -> true if all are '0'..'9'.
+    constexpr bool swarAllDigits(std::uint64_t chunk) noexcept {
+        return (chunk & 0xF0F0F0F0F0F0F0F0ULL) == kAsciiZeros
+               && ((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) == kAsciiZeros;
+    }
+
+    /// 8 ASCII digits, first character in the lowest byte -> their value (three multiply/shift steps).
+    constexpr std::uint64_t swarDigits8(std::uint64_t chunk) noexcept {
+        chunk -= kAsciiZeros;
+        chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+        chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+        return (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFULL;
+    }
+}
+
+namespace detail {
+    /// A scale resolved once for the SWAR path: log10(scale), or digits > 8 when it does not qualify.
+    struct SwarScale {
+        std::int64_t scale;
+        std::size_t digits;
+    };
+
+    constexpr SwarScale swarScale(std::int64_t scale) noexcept {
+        std::size_t digits = 0;
+        for (std::int64_t p = 1; p != scale; p *= 10) {
+            if (p > scale / 10 || ++digits > 8) return {scale, 9};
+        }
+        return {scale, digits};
+    }
+
+    /// See tryParseDecimalToScaledSwar(). Forced inline so the scale folds in and the batch loop
+    /// interleaves the price and quantity chains.
+    __attribute__((always_inline)) inline bool parseScaledSwar(std::string_view s, SwarScale sc, std::int64_t &out) noexcept {
+        if constexpr (std::endian::native != std::endian::little) return false;
+        if (sc.digits > 8 || s.empty()) return false;
+
+        const bool negative = (s.front() == '-');
+        if (negative) s.remove_prefix(1);
+        const std::size_t n = s.size();
+        if (n == 0 || n > 16) return false;
+
+        std::uint64_t lo, hi;
+        loadUpTo16(s.data(), n, lo, hi);
+
+        constexpr std::uint64_t dots = 0x2E2E2E2E2E2E2E2EULL;
+        std::size_t dot = firstZeroByte(lo ^ dots); // bytes above n are zero, never '.'
+        if (dot == 8) dot += firstZeroByte(hi ^ dots); // 16 = no dot
+        const std::size_t intLen = (dot < 16) ? dot : n;
+        if (intLen > 8) return false;
+
+        const std::size_t fracAt = dot + 1;
+        const std::size_t fracAvail = (dot < 16) ? n - fracAt : 0;
+        const std::size_t fracLen = fracAvail < sc.digits ? fracAvail : sc.digits;
+        const std::uint64_t fracBytes = (fracAt < 8)
+                                            ? (lo >> (8 * fracAt)) | (hi << (8 * (8 - fracAt)))
+                                            : hi >> ((8 * (fracAt - 8)) & 63);
+        const std::uint64_t frac = (fracBytes & byteMask(fracLen)) | (kAsciiZeros & ~byteMask(fracLen));
+
+        const std::uint64_t intDigits = rightAlignDigits(lo, intLen);
+        const std::uint64_t fracDigits = rightAlignDigits(frac, sc.digits);
+        if (!swarAllDigits(intDigits) || !swarAllDigits(fracDigits)) return false;
+
+        const auto value = static_cast<std::int64_t>(swarDigits8(intDigits) * static_cast<std::uint64_t>(sc.scale)
+                                                     + swarDigits8(fracDigits));
+        out = negative ? -value : value;
+        return true;
+    }
+}
+
+/// SWAR fast path of parseDecimalToScaled() for '[-]digits[.digits]' up to 16 characters with at most
+/// 8 integer digits and a power-of-ten scale up to 1e8 (every price/qty field venues send in practice).
+/// The field is loaded as two 64-bit lanes, the dot found with a zero-byte test, and the integer
+/// digits and the fraction (truncated/padded to log10(scale) digits) are each shifted into one
+/// 8-digit lane, validated and converted with three multiply/shift steps. Never reads past 's'.
+/// Returns false, leaving 'out' untouched, for anything else (and on big-endian hosts); the caller
+/// then takes the scalar path, so results and errors are exactly those of parseDecimalToScaledScalar().
+inline bool tryParseDecimalToScaledSwar(std::string_view s, std::int64_t scale, std::int64_t &out) noexcept {
+    return detail::parseScaledSwar(s, detail::swarScale(scale), out);
+}
+
+/// Parse a decimal string into integer ticks (see parseDecimalToScaledScalar for the semantics).
+/// Takes the SWAR path for the plain decimals venues send, the scalar one otherwise.
+inline std::int64_t parseDecimalToScaled(std::string_view s, std::int64_t scale) {
+    std::int64_t v = 0;
+    if (tryParseDecimalToScaledSwar(s, scale, v)) return v;
+    return parseDecimalToScaledScalar(s, scale);
+}
+
+/// Batch variant: fill priceTick / quantityLot of every level from its price / quantity text.
+/// The scales are resolved once per batch, and price and quantity of a level are independent,
+/// so their SWAR chains overlap in the pipeline.
+/// Throws std::invalid_argument on the first malformed field.
+inline void scaleLevels(std::span<Level> levels, std::int64_t priceScale, std::int64_t qtyScale) {
+    const detail::SwarScale px = detail::swarScale(priceScale);
+    const detail::SwarScale qt = detail::swarScale(qtyScale);
+    for (Level &l: levels) {
+        std::int64_t pxTick = 0, qtLot = 0;
+        const bool pxFast = detail::parseScaledSwar(l.price, px, pxTick);
+        const bool qtFast = detail::parseScaledSwar(l.quantity, qt, qtLot);
+        l.priceTick = pxFast ? pxTick : parseDecimalToScaledScalar(l.price, priceScale);
+        l.quantityLot = qtFast ? qtLot : parseDecimalToScaledScalar(l.quantity, qtyScale);
+    }
+}
+
 /// Convert a price string to integer ticks (price × 100, 2 decimal places).
 inline std::int64_t parsePriceToTicks(const std::string &s) {
     return parseDecimalToScaled(s, 100);
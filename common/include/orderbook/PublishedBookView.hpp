@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "orderbook/BookLevel.hpp"
+
+namespace md {
+    class OrderBook;
+
+    /**
+     * Reader-owned copy of one published top-N view.
+     */
+    struct BookViewSnapshot {
+        std::uint64_t version{0}; ///< number of publishes so far; +1 per applied update
+        std::uint64_t seqId{0};   ///< controller's applied sequence id at publish time (0 on seq-less venues)
+        bool synced{false};       ///< controller was Synced at publish time
+        std::size_t bidCount{0};
+        std::size_t askCount{0};
+        std::vector<BookLevel> bids; ///< first bidCount entries are valid, best first
+        std::vector<BookLevel> asks; ///< first askCount entries are valid, best first
+    };
+
+    /**
+     * Seqlock-protected top-N copy of a book, written by the feed thread and read by any other thread.
+     * - Single writer (the thread applying updates), any number of readers.
+     * - The writer never waits: it bumps the sequence to odd, stores the payload, bumps it to even.
+     * - Readers never block the writer: tryRead() copies the payload and reports a torn read (sequence
+     *   odd or changed while copying) by returning false; read() retries a bounded number of times.
+     * - The payload is stored as atomics (release stores / acquire loads), so concurrent access is
+     *   race-free by the memory model (TSAN-clean) while compiling to plain loads/stores on x86.
+     */
+    class PublishedBookView {
+    public:
+        explicit PublishedBookView(std::size_t topN);
+
+        PublishedBookView(const PublishedBookView &) = delete;
+        PublishedBookView &operator=(const PublishedBookView &) = delete;
+
+        /// Writer side: copy the top-N of 'book'. Must only be called from one thread.
+        void publish(const OrderBook &book, std::uint64_t seqId, bool synced) noexcept;
+
+        /// Reader side: one attempt. Returns false on a torn read ('out' content is then unspecified).
+        bool tryRead(BookViewSnapshot &out) const;
+
+        /// Reader side: retry tryRead up to 'maxAttempts' times.
+        bool read(BookViewSnapshot &out, std::size_t maxAttempts = 64) const;
+
+        /// Number of completed publishes (cheap change detection for pollers).
+        [[nodiscard]] std::uint64_t version() const noexcept { return seq.load(std::memory_order_acquire) / 2; }
+
+        [[nodiscard]] std::size_t topN() const noexcept { return n; }
+
+    private:
+        /// payload layout: [bid ticks | bid lots | ask ticks | ask lots], n entries each
+        std::size_t n;
+        std::unique_ptr<std::atomic<std::int64_t>[]> payload;
+        std::atomic<std::uint64_t> appliedSeq{0};
+        std::atomic<std::uint64_t> counts{0}; ///< bidCount | askCount << 32 | synced << 63
+
+        /// even = stable, odd = write in progress; on its own cache line, away from the payload header
+        alignas(64) std::atomic<std::uint64_t> seq{0};
+    };
+}
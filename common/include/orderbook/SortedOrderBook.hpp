@@ -0,0 +1,418 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include "orderbook/BookChange.hpp"
+#include "orderbook/BookLevel.hpp"
+#include "orderbook/BookShadow.hpp"
+#include "orderbook/InlineLevels.hpp"
+#include "orderbook/LevelSearch.hpp"
+
+/**
+ * Notes:
+ * - To confirm empirically, compile with optimizations (-O2/-O3) and check the emitted assembly (e.g., Compiler Explorer).
+ *   It should show two separate instantiations where the container address is fixed.
+ * - 'lower_bound' does a binary search O(log(N) and returns the insertion point.
+ *   update/remove use level_search::lowerBound instead (same result, branchless + SIMD window).
+ * - Check which is faster in this case, 'lower_bound' or 'find_if'
+ * - Both above needs already sorted lists !!!
+ */
+namespace md {
+    /**
+     * Contiguous sorted book: binary search + insert/erase per level.
+     * Default implementation behind md::OrderBook (see BookKind::Sorted).
+     * @tparam Levels - per-side storage: std::vector<BookLevel> (runtime depth, see SortedOrderBook)
+     *                  or InlineLevels<C> (compile-time capacity, see FixedOrderBook<N>)
+     */
+    template<typename Levels>
+    class BasicSortedOrderBook {
+    public:
+        explicit BasicSortedOrderBook(std::size_t depth) : depth(depth) {
+            if (depth == 0)
+                throw std::invalid_argument("OrderBook: depth must be greater than 0");
+
+            /// For both sides, (depth + 1) space alocated. The plus 1 is needed to not have any reallocation,
+            /// when the update of the Order Book exceeds the depth by 1 if it full and we have an update to it.
+            /// The update first insert and then pop_back,
+            /// so for a small fraction of time, we exceeds depth, and that would result reallocation. (See Option C. at update())
+            if constexpr (requires(Levels &l) { l.reserve(depth); }) {
+                bids.reserve(depth + 1);
+                asks.reserve(depth + 1);
+            } else {
+                if (depth + 1 > Levels::capacity())
+                    throw std::invalid_argument("OrderBook: depth exceeds the fixed capacity");
+            }
+        }
+
+        const BookLevel *bid_ptr(std::size_t i) const noexcept {
+            if (i >= bids.size()) return nullptr;
+            if (bids[i].isEmpty()) return nullptr;
+            return &bids[i];
+        }
+
+        const BookLevel *ask_ptr(std::size_t i) const noexcept {
+            if (i >= asks.size()) return nullptr;
+            if (asks[i].isEmpty()) return nullptr;
+            return &asks[i];
+        }
+
+        /**
+         * Original venue text of the level at depth i, or nullptr if out of range,
+         * empty, or text retention is disabled.
+         */
+        const LevelText *bid_text(std::size_t i) const noexcept {
+            const BookLevel *l = bid_ptr(i);
+            return l ? shadow.find<Side::BID>(l->priceTick) : nullptr;
+        }
+
+        const LevelText *ask_text(std::size_t i) const noexcept {
+            const BookLevel *l = ask_ptr(i);
+            return l ? shadow.find<Side::ASK>(l->priceTick) : nullptr;
+        }
+
+        void setRetainText(bool retain) { shadow.setRetain(retain); }
+
+        [[nodiscard]] bool retainsText() const noexcept { return shadow.retains(); }
+
+        void enableDepthIndex(std::size_t windowTicks) { shadow.enableDepthIndex(windowTicks); }
+
+        template<Side S>
+        [[nodiscard]] FillCost cost_to_fill(std::int64_t qtyLot) const { return shadow.costToFill<S>(*this, qtyLot); }
+
+        template<Side S>
+        [[nodiscard]] std::int64_t qty_within(std::int64_t priceTick) const {
+            return shadow.qtyWithin<S>(*this, priceTick);
+        }
+
+
+        /**
+         * 'update' handes the incoming updates to the order book from the exchange
+         * @tparam S - side of the orderbook (ask or bid)
+         * @param level - the update coming from the exchange
+         * @return the rank written (BookChange::bbo* are left to the caller)
+         */
+        template<Side S>
+        BookChange update(const Level &level) {
+            if (level.isEmpty()) return this->remove<S>(level.priceTick);
+
+            BookChange change;
+
+            Levels &vec = (S == Side::BID) ? bids : asks;
+            const std::int64_t updateTick = level.priceTick;
+
+            /// 'it' becomes the first position where the level is not strictly better than the tick
+            /// (std::lower_bound semantics, SIMD search; see LevelSearch.hpp)
+            typename Levels::iterator it = findLevel<S>(vec, updateTick);
+
+            /// Option A.: The item is in the order book, just the quantity of it updates.
+            if (it != vec.end() && it->priceTick == updateTick) {
+                it->quantityLot = level.quantityLot;
+                shadow.store<S>(level);
+                change.touch(static_cast<std::size_t>(it - vec.begin()));
+                return change;
+            }
+
+            /// Option B.: If we have room, insert anywhere (including end)
+            if (vec.size() < depth) {
+                change.touch(static_cast<std::size_t>(it - vec.begin()));
+                vec.insert(it, BookLevel{updateTick, level.quantityLot});
+                shadow.store<S>(level);
+                return change;
+            }
+
+            /// Option C.: insert only if it improves top-N (i.e., not at end)
+            if (it != vec.end()) {
+                change.touch(static_cast<std::size_t>(it - vec.begin()));
+                vec.insert(it, BookLevel{updateTick, level.quantityLot});
+                shadow.drop<S>(vec.back().priceTick);
+                vec.pop_back(); // drops last element, since depth have to be ensured
+                shadow.store<S>(level);
+            }
+            return change;
+        }
+
+        /**
+         * 'remove' erase the level which got quantity=0 update
+         * std::find_if does a linear scan - O(n)
+         * std::lower_bound does a binary search - O(log(n))
+         */
+        template<Side S>
+        BookChange remove(std::int64_t priceTick) {
+            Levels &vec = S == Side::BID ? bids : asks; // resolved at compile time
+            typename Levels::iterator it = findLevel<S>(vec, priceTick);
+
+            BookChange change;
+            if (it != vec.end() && it->priceTick == priceTick) {
+                change.touch(static_cast<std::size_t>(it - vec.begin()));
+                vec.erase(it);
+                shadow.drop<S>(priceTick);
+            }
+            return change;
+        }
+
+        /**
+         * 'applyBatch' applies all levels of one side of a venue message in a single linear pass:
+         * - the delta is sorted once and deduplicated (see LevelBatch)
+         * - pass 1 simulates the merge up to 'depth' outputs to learn how many book levels survive and
+         *   how many new levels get inserted
+         * - pass 2 shifts the surviving prefix right by that insert count and merges forward into the
+         *   freed front (in-place two-pointer merge, truncated at depth); very large batches that would
+         *   not fit the reserved storage merge through a scratch buffer instead
+         * Truncation happens once per batch, so a level is not lost just because an insert earlier in the
+         * same message temporarily pushed it past depth.
+         * Returns the range of output ranks where a batch level was written or removed.
+         */
+        template<Side S>
+        BookChange applyBatch(std::span<const Level> delta) {
+            if (delta.empty()) return {};
+            if (delta.size() == 1) return update<S>(delta.front());
+
+            const std::span<const BatchLevel> batch = scratch.prepare<S>(delta);
+
+            Levels &vec = (S == Side::BID) ? bids : asks;
+            const std::size_t n = vec.size();
+            const std::size_t m = batch.size();
+
+            /// Pass 1: count only.
+            std::size_t r = 0, j = 0, out = 0, inserts = 0;
+            while (out < depth && (r < n || j < m)) {
+                if (j == m || (r < n && better<S>(vec[r].priceTick, batch[j].priceTick))) {
+                    ++r;
+                    ++out;
+                } else if (r < n && vec[r].priceTick == batch[j].priceTick) {
+                    if (batch[j].quantityLot != 0) ++out;
+                    ++r;
+                    ++j;
+                } else {
+                    if (batch[j].quantityLot != 0) {
+                        ++inserts;
+                        ++out;
+                    }
+                    ++j;
+                }
+            }
+            const std::size_t consumed = r;
+
+            /// Book levels the merge never reached fall off the end.
+            for (std::size_t k = consumed; k < n; ++k) shadow.drop<S>(vec[k].priceTick);
+
+            /// Pass 2: make room at the front, then merge forward in place. The write index never overtakes
+            /// the read index (w <= consumed-so-far + inserts-so-far < r while inserts remain).
+            /// If the gap would not fit the depth + 1 slots the storage is sized for, merge through 'spill'.
+            const std::size_t need = consumed + inserts;
+            std::size_t w = 0;
+            BookChange change;
+            if (need <= depth + 1) {
+                vec.resize(need);
+                std::move_backward(vec.begin(), vec.begin() + static_cast<std::ptrdiff_t>(consumed), vec.end());
+                w = mergeInto<S>(vec.data() + inserts, consumed, batch, vec.data(), change);
+            } else {
+                spill.resize(depth);
+                w = mergeInto<S>(vec.data(), consumed, batch, spill.data(), change);
+                vec.resize(w);
+                std::copy(spill.begin(), spill.begin() + static_cast<std::ptrdiff_t>(w), vec.begin());
+            }
+            vec.resize(w);
+            return change;
+        }
+
+        /**
+         * 'load' replaces one side with a full snapshot side:
+         * - input already in book order (the usual venue layout): one linear pass that skips zero-qty
+         *   levels and stops at depth, no copy and no sort
+         * - otherwise the input is ordered through the batch scratch first
+         * A tick repeated in the input ends with its last entry.
+         */
+        template<Side S>
+        void load(std::span<const Level> levels) {
+            Levels &vec = (S == Side::BID) ? bids : asks;
+            vec.clear();
+            shadow.clear<S>();
+
+            const bool ordered = std::is_sorted(levels.begin(), levels.end(),
+                                                [](const Level &x, const Level &y) {
+                                                    return better<S>(x.priceTick, y.priceTick);
+                                                });
+            if (ordered) {
+                for (const Level &l: levels) {
+                    if (!vec.empty() && vec.back().priceTick == l.priceTick) {
+                        if (l.quantityLot != 0) {
+                            vec.back().quantityLot = l.quantityLot;
+                            shadow.store<S>(l);
+                        } else {
+                            vec.pop_back();
+                            shadow.drop<S>(l.priceTick);
+                        }
+                        continue;
+                    }
+                    if (vec.size() == depth) break;
+                    if (l.quantityLot == 0) continue;
+                    vec.push_back(BookLevel{l.priceTick, l.quantityLot});
+                    shadow.store<S>(l);
+                }
+                return;
+            }
+
+            for (const BatchLevel &b: scratch.prepare<S>(levels)) {
+                if (b.quantityLot == 0) continue;
+                vec.push_back(BookLevel{b.priceTick, b.quantityLot});
+                shadow.store<S>(*b.src);
+                if (vec.size() == depth) break;
+            }
+        }
+
+        /**
+ * Check price level uniqueness and sortedness
+ */
+        [[nodiscard]] bool validate() const {
+            // 1) Depth sanity
+            if (bids.size() > depth) return false;
+            if (asks.size() > depth) return false;
+
+            // 2) Sortedness + uniqueness:
+            // bids must be strictly decreasing: bids[i-1].priceTick > bids[i].priceTick
+            for (std::size_t i = 1; i < bids.size(); ++i) {
+                if (bids[i - 1].priceTick <= bids[i].priceTick) {
+                    return false; // not sorted DESC or duplicate tick
+                }
+            }
+
+            // asks must be strictly increasing: asks[i-1].priceTick < asks[i].priceTick
+            for (std::size_t i = 1; i < asks.size(); ++i) {
+                if (asks[i - 1].priceTick >= asks[i].priceTick) {
+                    return false; // not sorted ASC or duplicate tick
+                }
+            }
+
+            // 3) Reject empty levels lingering in book if there can be any
+            for (const BookLevel &l: bids) if (l.isEmpty()) return false;
+            for (const BookLevel &l: asks) if (l.isEmpty()) return false;
+
+            return true;
+        }
+
+        /**
+         * Clears the entire book.
+         * 
+         * - Both sides become empty; reserved capacity is kept.
+         * - The text side tables are emptied as well (their nodes are recycled), so is the depth index.
+         */
+        void clear() noexcept {
+            bids.clear();
+            asks.clear();
+            shadow.clear();
+        }
+
+        /**
+         * Returns the top-of-book bid level (index 0).
+         */
+        [[nodiscard]] const BookLevel &best_bid() const noexcept {
+            static const BookLevel empty{0, 0};
+            if (bids.empty()) return empty;
+            return bids.front();
+        }
+
+        /**
+         * Returns the top-of-book ask level (index 0).
+         */
+        [[nodiscard]] const BookLevel &best_ask() const noexcept {
+            static const BookLevel empty{0, 0};
+            if (asks.empty()) return empty;
+            return asks.front();
+        }
+
+    private:
+        template<Side S>
+        static typename Levels::iterator findLevel(Levels &vec, std::int64_t priceTick) noexcept {
+            return vec.begin() + static_cast<std::ptrdiff_t>(
+                       level_search::lowerBound<S>(vec.data(), vec.size(), priceTick));
+        }
+
+        /// true if tick a ranks ahead of tick b on side S
+        template<Side S>
+        static constexpr bool better(std::int64_t a, std::int64_t b) noexcept {
+            return (S == Side::BID) ? (a > b) : (a < b);
+        }
+
+        /**
+         * Forward two-pointer merge of 'srcN' book levels with the batch into 'dst', truncated at depth.
+         * 'src' may alias 'dst' at a higher offset (in-place case of applyBatch). Returns the output size;
+         * every output rank where a batch level lands or removes a book level is recorded in 'change'.
+         */
+        template<Side S>
+        std::size_t mergeInto(const BookLevel *src, std::size_t srcN, std::span<const BatchLevel> batch,
+                              BookLevel *dst, BookChange &change) {
+            const std::size_t m = batch.size();
+            std::size_t r = 0, j = 0, w = 0;
+            while (w < depth && (r < srcN || j < m)) {
+                if (j == m || (r < srcN && better<S>(src[r].priceTick, batch[j].priceTick))) {
+                    dst[w++] = src[r++];
+                } else if (r < srcN && src[r].priceTick == batch[j].priceTick) {
+                    change.touch(w);
+                    if (batch[j].quantityLot != 0) {
+                        dst[w++] = BookLevel{batch[j].priceTick, batch[j].quantityLot};
+                        shadow.store<S>(*batch[j].src);
+                    } else {
+                        shadow.drop<S>(batch[j].priceTick);
+                    }
+                    ++r;
+                    ++j;
+                } else {
+                    if (batch[j].quantityLot != 0) {
+                        change.touch(w);
+                        dst[w++] = BookLevel{batch[j].priceTick, batch[j].quantityLot};
+                        shadow.store<S>(*batch[j].src);
+                    }
+                    ++j;
+                }
+            }
+            return w;
+        }
+
+        std::size_t depth;
+
+        /**
+         * sorted descending by priceTick
+         */
+        Levels bids;
+
+        /**
+         * sorted ascending by priceTick
+         */
+        Levels asks;
+
+        /**
+         * Cold side tables: original decimal text keyed by priceTick (only when retention is on),
+         * plus the optional cumulative-depth index.
+         */
+        BookShadow shadow;
+
+        /**
+         * Scratch for applyBatch; capacity persists across messages.
+         */
+        LevelBatch scratch;
+
+        /**
+         * Output buffer for batches too large to merge in place (grows once to depth).
+         */
+        std::vector<BookLevel> spill;
+    };
+
+    /**
+     * Runtime depth: both sides in heap vectors reserved to depth + 1.
+     */
+    using SortedOrderBook = BasicSortedOrderBook<std::vector<BookLevel>>;
+
+    /**
+     * Compile-time depth N: both sides stored inline (one object, no per-side allocation).
+     * The inline capacity leaves room for a reserve band of up to N / 2 levels behind the published N,
+     * so the runtime depth passed to the constructor may be anything in [1, N + N / 2].
+     * md::OrderBook picks an instantiation automatically for the depths we deploy (20 / 50 / 400).
+     */
+    template<std::size_t N>
+    using FixedOrderBook = BasicSortedOrderBook<InlineLevels<N + N / 2 + 1>>;
+}
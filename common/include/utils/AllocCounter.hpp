@@ -0,0 +1,25 @@
+#pragma once
+
+// Heap allocation counter for hot-path allocation audits.
+//
+// Built with -DPOP_COUNT_ALLOCS=ON, AllocCounter.cpp replaces the global operator new
+// (all forms funnel into it) and counts every allocation made by the calling thread.
+// Without the option nothing is replaced and threadCount() is a constant 0, so callers
+// can take deltas unconditionally and gate reporting on alloc::kCounting.
+
+#include <cstdint>
+
+namespace md::alloc {
+#ifdef POP_COUNT_ALLOCS
+    inline constexpr bool kCounting = true;
+
+    extern thread_local std::uint64_t t_count;
+
+    /// Heap allocations made by the calling thread since it started.
+    inline std::uint64_t threadCount() noexcept { return t_count; }
+#else
+    inline constexpr bool kCounting = false;
+
+    inline std::uint64_t threadCount() noexcept { return 0; }
+#endif
+} // namespace md::alloc
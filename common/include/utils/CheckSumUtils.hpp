@@ -1,11 +1,11 @@
 #pragma once
 
 #include <string_view>
-#include <boost/crc.hpp>
 #include <cstddef>
 #include <cstdint>
-#include <string>
+#include <cstring>
 #include "orderbook/OrderBook.hpp"
+#include "utils/Crc32.hpp"
 
 namespace md {
     class OrderBook;
@@ -14,44 +14,81 @@ namespace md {
                                std::int64_t expected_checksum,
                                std::size_t topN) noexcept;
 
-    inline std::uint32_t CRC32Checksum(std::string_view s) {
-        boost::crc_32_type result;
-        result.process_bytes(s.data(), s.size());
-        return result.checksum();
+    inline std::uint32_t CRC32Checksum(std::string_view s) noexcept {
+        return crc32::compute(s);
     }
 
     inline std::int64_t CRC32ToSigned(std::uint32_t u) noexcept {
         return static_cast<std::int32_t>(u); // preserve bit pattern
     }
 
-    /// Need read access to top levels.
-    /// returning nullptr if i out of range / empty.
-    inline bool checkBitgetCRC32(const OrderBook &book,
-                                 std::int64_t expected,
-                                 std::size_t topN) noexcept {
-        std::string s;
-        s.reserve(topN * 64);
+    /**
+     * Streams text into a CRC-32 through a fixed stack buffer: the checksum string is never
+     * materialised on the heap. A top-25 book string fits the buffer, so the CRC kernel normally
+     * runs once over the whole string.
+     */
+    class Crc32Writer {
+    public:
+        void append(std::string_view s) noexcept {
+            if (n_ + s.size() > kCapacity) {
+                flush_();
+                if (s.size() > kCapacity) {
+                    crc_ = crc32::update(crc_, s.data(), s.size());
+                    return;
+                }
+            }
+            std::memcpy(buf_ + n_, s.data(), s.size());
+            n_ += s.size();
+        }
+
+        std::uint32_t finish() noexcept {
+            flush_();
+            return crc_;
+        }
+
+    private:
+        static constexpr std::size_t kCapacity = 2048;
+
+        void flush_() noexcept {
+            crc_ = crc32::update(crc_, buf_, n_);
+            n_ = 0;
+        }
+
+        char buf_[kCapacity];
+        std::size_t n_{0};
+        std::uint32_t crc_{0};
+    };
+
+    /// OKX / Bitget book checksum: CRC-32 of "bid1px:bid1qty:ask1px:ask1qty:bid2px:..." over the top
+    /// 'topN' levels (a side that runs out is skipped), compared as a signed 32-bit value.
+    /// Needs the levels' original text, so the book must retain it; returns false otherwise.
+    inline bool checkInterleavedCRC32(const OrderBook &book,
+                                      std::int64_t expected,
+                                      std::size_t topN) noexcept {
+        Crc32Writer w;
 
         bool first = true;
-        auto append = [&](const std::string &tok) {
-            if (!first) s.push_back(':');
+        auto append = [&](std::string_view tok) {
+            if (!first) w.append(":");
             first = false;
-            s.append(tok);
+            w.append(tok);
         };
 
         for (std::size_t i = 0; i < topN; ++i) {
-            if (const Level *b = book.bid_ptr(i)) {
+            if (book.bid_ptr(i)) {
+                const LevelText *b = book.bid_text(i);
+                if (!b) return false; // text not retained -> cannot reproduce venue string
                 append(b->price);
                 append(b->quantity);
             }
-            if (const Level *a = book.ask_ptr(i)) {
+            if (book.ask_ptr(i)) {
+                const LevelText *a = book.ask_text(i);
+                if (!a) return false;
                 append(a->price);
                 append(a->quantity);
             }
         }
 
-        const std::uint32_t u = CRC32Checksum(s);
-        const std::int64_t local = CRC32ToSigned(u);
-        return local == expected;
+        return CRC32ToSigned(w.finish()) == expected;
     }
 }
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Notes:
+ * - CRC-32 (IEEE 802.3, reflected, init/xorout 0xFFFFFFFF): the value zlib's crc32() and
+ *   boost::crc_32_type produce, and the one OKX / Bitget publish as their book checksum.
+ * - x86-64 hosts with PCLMULQDQ fold 64-byte blocks with carry-less multiplies (Intel,
+ *   "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ"); short inputs, the sub-16-byte
+ *   tail and hosts without it use slicing-by-8 tables. Picked at runtime (cpuid, once per process).
+ * - update() chains: update(update(0, a), b) == crc of a followed by b, so a caller may feed a
+ *   long message through a small buffer.
+ */
+namespace md::crc32 {
+    /// Continue 'crc' (0 for a fresh checksum) over [data, data + len).
+    std::uint32_t update(std::uint32_t crc, const void *data, std::size_t len) noexcept;
+
+    inline std::uint32_t compute(std::string_view s) noexcept { return update(0, s.data(), s.size()); }
+
+    /// True when update() runs the PCLMULQDQ kernel on this host.
+    bool accelerated() noexcept;
+}
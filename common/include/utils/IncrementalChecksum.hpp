@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "orderbook/BookChange.hpp"
+#include "orderbook/OrderBook.hpp"
+
+/**
+ * Notes:
+ * - Keeps the checkInterleavedCRC32 value ("bid1px:bid1qty:ask1px:ask1qty:...") up to date from
+ *   the ranks each update touched, instead of re-serialising the top N levels per update.
+ * - Per side and rank it caches the level's (priceTick, quantityLot) and its "px:qty" text. Ranks
+ *   above the shallowest touched rank are reused as they are; from there on levels are matched
+ *   against the cache by price (a two-pointer walk, so inserts / removes that shift the side cost
+ *   nothing), and only levels whose price or quantity changed are looked up in the text table.
+ * - CRC-32 is computed left to right, so the string is resumed from a checkpoint at or above the
+ *   first changed rank (CRC state + length, recorded every ~256 bytes so the PCLMULQDQ kernel still
+ *   gets long runs) and only the suffix is hashed again.
+ * - Cached tokens are 24-byte PODs pointing into a pool of text slots, so a shift moves no strings
+ *   and steady state does not allocate.
+ * - An update that touched no rank inside the top N (the common deep-book case) reuses the cached
+ *   value: constant cost.
+ * - A level's text is assumed to be a function of its (price, quantity), i.e. the venue renders a
+ *   value one way. The controller recomputes from scratch before reporting a mismatch, so a venue
+ *   that breaks this costs a recomputation, not a spurious resync.
+ */
+namespace md {
+    class InterleavedCrc32Tracker {
+    public:
+        /// Forget everything (snapshot, reset): the next value() serialises the full top N.
+        void invalidate() noexcept;
+
+        /// Record what an applied update did to the book; changes accumulate until value().
+        void noteChange(const BookChange &change) noexcept;
+
+        /// Checksum of the current top 'topN' levels; nullopt if the book does not retain level text.
+        std::optional<std::uint32_t> value(const OrderBook &book, std::size_t topN);
+
+    private:
+        static constexpr std::uint32_t kNoSlot = 0xffffffffU;
+
+        struct Token {
+            std::int64_t tick{0};
+            std::int64_t lot{0};
+            std::uint32_t slot{kNoSlot}; ///< "px:qty" in text_[slot]; tokens move, the text stays put
+        };
+
+        struct Checkpoint {
+            std::size_t rank; ///< string state before this rank
+            std::uint32_t crc;
+            std::size_t len;
+        };
+
+        template<Side S>
+        bool refreshSide_(const OrderBook &book, std::size_t from, std::size_t topN);
+
+        void rehash_(std::size_t from);
+
+        std::uint32_t takeSlot_();
+
+        std::vector<Token> tokens_[2]; ///< [0] bids, [1] asks; first count_[side] entries valid
+        std::vector<Token> scratch_;
+        std::size_t count_[2]{0, 0};
+        std::vector<std::string> text_; ///< slot pool; strings keep their capacity
+        std::vector<std::uint32_t> freeSlots_;
+        std::vector<Checkpoint> checkpoints_;
+        std::vector<char> buf_; ///< suffix being hashed; grows to the longest run between checkpoints
+
+        std::size_t topN_{0};
+        std::size_t dirtyFrom_{0}; ///< shallowest rank changed since the last value(); topN_ = clean
+        bool valid_{false};
+        std::uint32_t crc_{0};
+    };
+}
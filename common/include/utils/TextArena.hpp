@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace md {
+    /**
+     * Bump allocator for short text owned by one message (level price / quantity copies).
+     * - store() copies into the current block and returns a view that stays valid until clear():
+     *   blocks never move, so growing the arena does not invalidate earlier views, and moving the
+     *   arena (e.g. a message into a buffer) keeps them valid as well.
+     * - clear() rewinds without freeing, so a reused message stops allocating once its blocks
+     *   cover the largest message seen.
+     */
+    class TextArena {
+    public:
+        TextArena() = default;
+        TextArena(TextArena &&) noexcept = default;
+        TextArena &operator=(TextArena &&) noexcept = default;
+        TextArena(const TextArena &) = delete;
+        TextArena &operator=(const TextArena &) = delete;
+
+        [[nodiscard]] std::string_view store(std::string_view s) {
+            if (s.empty()) return {};
+            while (block_ < blocks_.size() && used_ + s.size() > blocks_[block_].size) {
+                ++block_;
+                used_ = 0;
+            }
+            if (block_ == blocks_.size()) {
+                const std::size_t size = std::max(kBlockSize, s.size());
+                blocks_.push_back(Block{std::make_unique_for_overwrite<char[]>(size), size});
+                used_ = 0;
+            }
+            char *dst = blocks_[block_].data.get() + used_;
+            std::memcpy(dst, s.data(), s.size());
+            used_ += s.size();
+            return {dst, s.size()};
+        }
+
+        void clear() noexcept {
+            block_ = 0;
+            used_ = 0;
+        }
+
+    private:
+        static constexpr std::size_t kBlockSize = 4096;
+
+        struct Block {
+            std::unique_ptr<char[]> data;
+            std::size_t size;
+        };
+
+        std::vector<Block> blocks_;
+        std::size_t block_{0}; ///< block being filled
+        std::size_t used_{0}; ///< bytes used in blocks_[block_]
+    };
+}
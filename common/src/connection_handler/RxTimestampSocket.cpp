@@ -0,0 +1,73 @@
+#include "connection_handler/RxTimestampSocket.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <ctime>
+#endif
+
+namespace md {
+    bool RxTimestampSocket::enableTimestamps(bool on) noexcept {
+        last_rx_ns_ = 0;
+        enabled_ = false;
+        if (!on) return true;
+#if defined(__linux__)
+        const int one = 1;
+        if (::setsockopt(sock_.native_handle(), SOL_SOCKET, SO_TIMESTAMPNS, &one, sizeof(one)) != 0) return false;
+        enabled_ = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::size_t RxTimestampSocket::recv_(const boost::asio::mutable_buffer *bufs, std::size_t count,
+                                         boost::beast::error_code &ec) {
+#if defined(__linux__)
+        iovec iov[kMaxBuffers];
+        for (std::size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = bufs[i].data();
+            iov[i].iov_len = bufs[i].size();
+        }
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(timespec))];
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t n;
+        do {
+            n = ::recvmsg(sock_.native_handle(), &msg, MSG_DONTWAIT);
+        } while (n < 0 && errno == EINTR);
+
+        if (n < 0) {
+            ec = (errno == EAGAIN || errno == EWOULDBLOCK)
+                     ? boost::beast::error_code(boost::asio::error::would_block)
+                     : boost::beast::error_code(errno, boost::system::system_category());
+            return 0;
+        }
+        if (n == 0 && count > 0) {
+            ec = boost::asio::error::eof;
+            return 0;
+        }
+        for (cmsghdr *c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec ts;
+                std::memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+                last_rx_ns_ = static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000LL + ts.tv_nsec;
+            }
+        }
+        ec = {};
+        return static_cast<std::size_t>(n);
+#else
+        (void) bufs;
+        (void) count;
+        ec = boost::asio::error::operation_not_supported;
+        return 0;
+#endif
+    }
+}
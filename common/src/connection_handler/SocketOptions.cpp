@@ -0,0 +1,87 @@
+#include "connection_handler/SocketOptions.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace md {
+    namespace {
+        void note_(std::string &failed, const char *what, const std::string &why) {
+            if (!failed.empty()) failed += ", ";
+            failed += what;
+            failed += ": ";
+            failed += why;
+        }
+
+#if defined(__linux__)
+        bool setInt_(int fd, int level, int name, int value, std::string &why) {
+            if (::setsockopt(fd, level, name, &value, sizeof(value)) == 0) return true;
+            why = std::strerror(errno);
+            return false;
+        }
+#endif
+    }
+
+    std::string applySocketOptions(boost::asio::ip::tcp::socket &sock, const SocketOptions &opts) {
+        namespace net = boost::asio;
+        std::string failed;
+        boost::system::error_code ec;
+
+        sock.set_option(net::ip::tcp::no_delay(opts.tcp_nodelay), ec);
+        if (ec) note_(failed, "tcp_nodelay", ec.message());
+        if (opts.rcvbuf > 0) {
+            sock.set_option(net::socket_base::receive_buffer_size(opts.rcvbuf), ec);
+            if (ec) note_(failed, "rcvbuf", ec.message());
+        }
+        if (opts.sndbuf > 0) {
+            sock.set_option(net::socket_base::send_buffer_size(opts.sndbuf), ec);
+            if (ec) note_(failed, "sndbuf", ec.message());
+        }
+
+#if defined(__linux__)
+        const int fd = sock.native_handle();
+        std::string why;
+        if (opts.busy_poll_us > 0 && !setInt_(fd, SOL_SOCKET, SO_BUSY_POLL, opts.busy_poll_us, why))
+            note_(failed, "busy_poll", why);
+        if (opts.quickack && !setInt_(fd, IPPROTO_TCP, TCP_QUICKACK, 1, why))
+            note_(failed, "quickack", why);
+        if (opts.tos >= 0) {
+            const bool v6 = sock.local_endpoint(ec).address().is_v6();
+            const bool ok = v6 ? setInt_(fd, IPPROTO_IPV6, IPV6_TCLASS, opts.tos, why)
+                               : setInt_(fd, IPPROTO_IP, IP_TOS, opts.tos, why);
+            if (!ok) note_(failed, "tos", why);
+        }
+#else
+        if (opts.busy_poll_us > 0) note_(failed, "busy_poll", "unsupported on this platform");
+        if (opts.quickack) note_(failed, "quickack", "unsupported on this platform");
+        if (opts.tos >= 0) note_(failed, "tos", "unsupported on this platform");
+#endif
+        return failed;
+    }
+
+    void rearmQuickAck(boost::asio::ip::tcp::socket &sock, const SocketOptions &opts) noexcept {
+#if defined(__linux__)
+        if (!opts.quickack) return;
+        const int one = 1;
+        (void) ::setsockopt(sock.native_handle(), IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+#else
+        (void) sock;
+        (void) opts;
+#endif
+    }
+
+    std::string describe(const SocketOptions &opts) {
+        auto bytes = [](int v) { return v > 0 ? std::to_string(v) : std::string("default"); };
+        return std::string("nodelay=") + (opts.tcp_nodelay ? "on" : "off") +
+               " rcvbuf=" + bytes(opts.rcvbuf) +
+               " sndbuf=" + bytes(opts.sndbuf) +
+               " busy_poll_us=" + std::to_string(opts.busy_poll_us) +
+               " quickack=" + (opts.quickack ? "on" : "off") +
+               " tos=" + (opts.tos >= 0 ? std::to_string(opts.tos) : std::string("default"));
+    }
+}
@@ -83,7 +83,7 @@ namespace md {
                                   // the same ssl::stream object.
                                   beast::get_lowest_layer(self->ws_).cancel(ignored);
                                   beast::get_lowest_layer(self->ws_).close(ignored);
-                                  SSL_clear(self->ws_.next_layer().native_handle());
+                                  SSL_clear(self->tls_().native_handle());
 
                                   // Reset state
                                   self->closing_ = false;
@@ -94,7 +94,8 @@ namespace md {
                                   self->write_in_flight_ = false;
 
                                   self->buffer_.consume(self->buffer_.size());
-                                  self->message_.clear();
+                                  self->ws_.next_layer().traffic() = {}; // stats are per connection
+                                  self->ws_.set_option(toPermessageDeflate(self->deflate_, /*server=*/false));
 
                                   self->host_ = std::move(host);
                                   self->port_ = std::move(port);
@@ -105,11 +106,11 @@ namespace md {
 
                                   // Configure hostname verification for this host
                                   if (self->tls_verify_peer_) {
-                                      self->ws_.next_layer().set_verify_mode(ssl::verify_peer);
-                                      self->ws_.next_layer().set_verify_callback(
+                                      self->tls_().set_verify_mode(ssl::verify_peer);
+                                      self->tls_().set_verify_callback(
                                           ssl::rfc2818_verification(self->host_));
                                   } else {
-                                      self->ws_.next_layer().set_verify_mode(ssl::verify_none);
+                                      self->tls_().set_verify_mode(ssl::verify_none);
                                   }
 
                                   self->arm_connect_deadline_();
@@ -141,9 +142,15 @@ namespace md {
                                            if (self->closing_) return; // prevent late continuation
                                            if (ec) return self->fail_(ec, "tcp_connect");
 
+                                           const std::string failed = applySocketOptions(
+                                               beast::get_lowest_layer(self->ws_), self->sock_opts_);
+                                           if (!failed.empty()) self->emit_log_("[WsClient] socket options: " + failed);
+                                           if (!self->tls_().next_layer().enableTimestamps(self->kernel_rx_ts_))
+                                               self->emit_log_("[WsClient] kernel rx timestamps unavailable");
+
                                            // SNI
                                            if (!SSL_set_tlsext_host_name(
-                                               self->ws_.next_layer().native_handle(), self->host_.c_str())) {
+                                               self->tls_().native_handle(), self->host_.c_str())) {
                                                const boost::system::error_code sni_ec{
                                                    static_cast<int>(::ERR_get_error()),
                                                    boost::asio::error::get_ssl_category()
@@ -159,7 +166,7 @@ namespace md {
 
     void WsClient::do_tls_handshake_() {
         auto self = shared_from_this();
-        ws_.next_layer().async_handshake(
+        tls_().async_handshake(
             ssl::stream_base::client,
             boost::asio::bind_executor(strand_,
                                        [self](const beast::error_code &ec) {
@@ -188,6 +195,7 @@ namespace md {
                                            self->start_write_(); // flush queued subscription frame
 
                                            if (self->on_open_) {
+                                               Meter::UserScope user(self->ws_.next_layer());
                                                try { self->on_open_(); } catch (...) {
                                                }
                                            }
@@ -202,6 +210,7 @@ namespace md {
     void WsClient::do_read_() {
         auto self = shared_from_this();
 
+        Meter::CodecScope codec(ws_.next_layer());
         ws_.async_read(
             buffer_,
             boost::asio::bind_executor(strand_,
@@ -220,12 +229,16 @@ namespace md {
                                                return self->fail_(ec, "read");
                                            }
 
-                                           // Avoid repeated allocations by reusing message_ capacity.
-                                           self->message_.assign(beast::buffers_to_string(self->buffer_.data()));
-
+                                           // Hand the handler the frame in place (flat_buffer storage is contiguous);
+                                           // consume only afterwards. Consuming everything rewinds the buffer but
+                                           // keeps its capacity, so steady-state reads do not allocate.
+                                           rearmQuickAck(beast::get_lowest_layer(self->ws_), self->sock_opts_);
+                                           const auto frame = self->buffer_.data();
+                                           self->ws_.next_layer().traffic().payload_in += frame.size();
                                            if (self->on_raw_message_) {
+                                               Meter::UserScope user(self->ws_.next_layer());
                                                try {
-                                                   self->on_raw_message_(self->message_.data(), self->message_.size());
+                                                   self->on_raw_message_(static_cast<const char *>(frame.data()), frame.size());
                                                } catch (...) {
                                                }
                                            }
@@ -264,13 +277,15 @@ namespace md {
         write_in_flight_ = true;
 
         auto self = shared_from_this();
+        Meter::CodecScope codec(ws_.next_layer()); // compresses (part of) the message before returning
         ws_.async_write(
             boost::asio::buffer(outbox_.front()),
             boost::asio::bind_executor(strand_,
-                                       [self](const beast::error_code &ec, std::size_t) {
+                                       [self](const beast::error_code &ec, std::size_t n) {
                                            self->write_in_flight_ = false;
 
                                            if (ec) return self->fail_(ec, "write");
+                                           self->ws_.next_layer().traffic().payload_out += n;
 
                                            self->outbox_.pop_front();
                                            self->start_write_();
@@ -413,6 +428,7 @@ namespace md {
         if (close_notified_.exchange(true, std::memory_order_acq_rel)) return;
 
         if (on_close_) {
+            Meter::UserScope user(ws_.next_layer());
             try { on_close_(); } catch (...) {
             }
         }
@@ -40,6 +40,21 @@ namespace md {
         return Action::NeedResync;
     }
 
+    bool OrderBookController::validateChecksum(std::int64_t expected) noexcept {
+        if (!checksum_fn_) return true;
+        if (crc_tracker_) {
+            try {
+                const auto crc = crc_tracker_->value(book_, checksum_topN_);
+                if (crc && CRC32ToSigned(*crc) == expected) return true;
+            } catch (...) {
+                // allocation failure while caching: fall through to the full recomputation
+            }
+            // Confirm a mismatch from scratch before it costs a resync (see InterleavedCrc32Tracker).
+            crc_tracker_->invalidate();
+        }
+        return checksum_fn_(book_, expected, checksum_topN_);
+    }
+
     OrderBookController::Action
     OrderBookController::onSnapshot(const GenericSnapshotFormat &msg, BaselineKind kind) {
         resetBook();
@@ -47,29 +62,20 @@ namespace md {
                      (kind == BaselineKind::WsAuthoritative ? "ws_authoritative" : "rest_anchored"),
                      msg.lastUpdateId, msg.bids.size(), msg.asks.size());
 
-        std::vector<Level> bids = msg.bids;
-        std::vector<Level> asks = msg.asks;
-
         // B7: zero-qty levels in a snapshot are anomalous (in incrementals they are
         // valid remove signals, but a snapshot should only contain resting liquidity).
-        auto skip_zero_qty = [](const Level &l) {
-            if (l.quantityLot == 0) {
-                spdlog::debug("[OBC] snapshot zero-qty level skipped priceTick={}", l.priceTick);
-                return true;
-            }
-            return false;
-        };
-        std::erase_if(bids, skip_zero_qty);
-        std::erase_if(asks, skip_zero_qty);
-
-        std::sort(asks.begin(), asks.end(),
-                  [](const Level &x, const Level &y) { return x.priceTick < y.priceTick; });
-
-        std::sort(bids.begin(), bids.end(),
-                  [](const Level &x, const Level &y) { return x.priceTick > y.priceTick; });
+        // load() skips them, so they are only logged here.
+        if (spdlog::should_log(spdlog::level::debug)) {
+            for (const auto *side: {&msg.bids, &msg.asks})
+                for (const Level &l: *side)
+                    if (l.quantityLot == 0)
+                        spdlog::debug("[OBC] snapshot zero-qty level skipped priceTick={}", l.priceTick);
+        }
 
-        for (const Level &lvl: bids) book_.update<Side::BID>(lvl);
-        for (const Level &lvl: asks) book_.update<Side::ASK>(lvl);
+        // Bulk load straight from the message: one pass when the venue sends book order,
+        // truncated to depth (a 5000-level REST snapshot only materialises the top-N).
+        book_.load<Side::BID>(msg.bids);
+        book_.load<Side::ASK>(msg.asks);
 
         last_seq_ = msg.lastUpdateId;
         expected_seq_ = last_seq_ + 1;
@@ -93,11 +99,20 @@ namespace md {
                        : BookSyncState::WaitingBridge,
                    "snapshot_applied");
 
+        publishView_();
         return Action::None;
     }
 
     OrderBookController::Action
-    OrderBookController::onIncrement(const GenericIncrementalFormat &msg) {
+    OrderBookController::onIncrement(const GenericIncrementalFormat &msg, BookChange *change) {
+        last_change_ = {};
+        const Action action = processIncrement_(msg);
+        if (change) *change = last_change_;
+        return action;
+    }
+
+    OrderBookController::Action
+    OrderBookController::processIncrement_(const GenericIncrementalFormat &msg) {
         if (state_ == BookSyncState::WaitingSnapshot) {
             return Action::None; // handler buffers
         }
@@ -174,6 +189,7 @@ namespace md {
                 }
             }
 
+            publishView_();
             return Action::None;
         }
 
@@ -237,11 +253,13 @@ namespace md {
             return need_resync_("required_checksum_absent", msg.first_seq, msg.last_seq, expected_seq_);
         }
 
+        publishView_();
         return Action::None;
     }
 
     void OrderBookController::applyIncrementUpdate(const GenericIncrementalFormat &upd) {
-        for (const Level &lvl: upd.bids) book_.update<Side::BID>(lvl);
-        for (const Level &lvl: upd.asks) book_.update<Side::ASK>(lvl);
+        last_change_ = book_.applyBatch<Side::BID>(upd.bids);
+        last_change_ |= book_.applyBatch<Side::ASK>(upd.asks);
+        if (crc_tracker_) crc_tracker_->noteChange(last_change_);
     }
 } // namespace md
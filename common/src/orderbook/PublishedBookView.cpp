@@ -0,0 +1,79 @@
+#include "orderbook/PublishedBookView.hpp"
+#include "orderbook/OrderBook.hpp"
+
+#include <algorithm>
+
+namespace md {
+    namespace {
+        constexpr std::uint64_t kCountMask = 0x7fffffffULL;
+        constexpr std::uint64_t kSyncedBit = 1ULL << 63;
+    }
+
+    PublishedBookView::PublishedBookView(std::size_t topN)
+        : n(topN),
+          payload(new std::atomic<std::int64_t>[4 * topN]) {
+        for (std::size_t i = 0; i < 4 * n; ++i) payload[i].store(0, std::memory_order_relaxed);
+    }
+
+    void PublishedBookView::publish(const OrderBook &book, std::uint64_t seqId, bool synced) noexcept {
+        const std::uint64_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+
+        /// Release stores keep the odd marker above from sinking below any payload store
+        /// (plain movs on x86; no fence, which TSAN cannot model).
+        std::size_t nb = 0, na = 0;
+        for (; nb < n; ++nb) {
+            const BookLevel *l = book.bid_ptr(nb);
+            if (!l) break;
+            payload[nb].store(l->priceTick, std::memory_order_release);
+            payload[n + nb].store(l->quantityLot, std::memory_order_release);
+        }
+        for (; na < n; ++na) {
+            const BookLevel *l = book.ask_ptr(na);
+            if (!l) break;
+            payload[2 * n + na].store(l->priceTick, std::memory_order_release);
+            payload[3 * n + na].store(l->quantityLot, std::memory_order_release);
+        }
+        appliedSeq.store(seqId, std::memory_order_release);
+        counts.store(nb | (static_cast<std::uint64_t>(na) << 32) | (synced ? kSyncedBit : 0),
+                     std::memory_order_release);
+
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    bool PublishedBookView::tryRead(BookViewSnapshot &out) const {
+        if (out.bids.size() < n) out.bids.resize(n);
+        if (out.asks.size() < n) out.asks.resize(n);
+
+        const std::uint64_t s1 = seq.load(std::memory_order_acquire);
+        if (s1 & 1) return false;
+
+        /// Acquire loads keep the re-check below from rising above any payload load.
+        const std::uint64_t c = counts.load(std::memory_order_acquire);
+        const std::size_t nb = std::min<std::size_t>(c & kCountMask, n);
+        const std::size_t na = std::min<std::size_t>((c >> 32) & kCountMask, n);
+        for (std::size_t i = 0; i < nb; ++i) {
+            out.bids[i].priceTick = payload[i].load(std::memory_order_acquire);
+            out.bids[i].quantityLot = payload[n + i].load(std::memory_order_acquire);
+        }
+        for (std::size_t i = 0; i < na; ++i) {
+            out.asks[i].priceTick = payload[2 * n + i].load(std::memory_order_acquire);
+            out.asks[i].quantityLot = payload[3 * n + i].load(std::memory_order_acquire);
+        }
+        out.seqId = appliedSeq.load(std::memory_order_acquire);
+
+        if (seq.load(std::memory_order_relaxed) != s1) return false;
+
+        out.version = s1 / 2;
+        out.synced = (c & kSyncedBit) != 0;
+        out.bidCount = nb;
+        out.askCount = na;
+        return true;
+    }
+
+    bool PublishedBookView::read(BookViewSnapshot &out, std::size_t maxAttempts) const {
+        for (std::size_t i = 0; i < maxAttempts; ++i)
+            if (tryRead(out)) return true;
+        return false;
+    }
+} // namespace md
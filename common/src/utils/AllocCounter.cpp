@@ -0,0 +1,32 @@
+#include "utils/AllocCounter.hpp"
+
+#ifdef POP_COUNT_ALLOCS
+
+#include <cstdlib>
+#include <new>
+
+namespace md::alloc {
+    thread_local std::uint64_t t_count = 0;
+} // namespace md::alloc
+
+// Replacement allocation functions. The sized/array/nothrow forms of the standard library
+// forward to these two; delete is the default (std::free compatible) one.
+void *operator new(std::size_t size) {
+    ++md::alloc::t_count;
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+    ++md::alloc::t_count;
+    const auto a = static_cast<std::size_t>(align);
+    if (void *p = std::aligned_alloc(a, size ? (size + a - 1) / a * a : a)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif
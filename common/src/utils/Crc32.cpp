@@ -0,0 +1,133 @@
+#include "utils/Crc32.hpp"
+
+#include <array>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MD_CRC32_CLMUL 1
+#include <immintrin.h>
+#endif
+
+namespace md::crc32 {
+    namespace {
+        constexpr std::uint32_t kPoly = 0xEDB88320u; ///< 0x04C11DB7 bit-reflected
+
+        /// Slicing-by-8 tables: kTables[0] is the classic byte table, kTables[k][b] advances byte b
+        /// through k more zero bytes, so eight input bytes take eight independent lookups.
+        constexpr std::array<std::array<std::uint32_t, 256>, 8> kTables = [] {
+            std::array<std::array<std::uint32_t, 256>, 8> t{};
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (kPoly & (0u - (c & 1u)));
+                t[0][i] = c;
+            }
+            for (std::size_t k = 1; k < 8; ++k)
+                for (std::size_t i = 0; i < 256; ++i)
+                    t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFFu];
+            return t;
+        }();
+
+        /// 'c' is the raw (un-inverted) register.
+        std::uint32_t tableUpdate(std::uint32_t c, const unsigned char *p, std::size_t n) noexcept {
+            for (; n >= 8; p += 8, n -= 8) {
+                const std::uint32_t lo = c ^ (static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8 |
+                                              static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24);
+                c = kTables[7][lo & 0xFFu] ^ kTables[6][(lo >> 8) & 0xFFu] ^
+                    kTables[5][(lo >> 16) & 0xFFu] ^ kTables[4][lo >> 24] ^
+                    kTables[3][p[4]] ^ kTables[2][p[5]] ^ kTables[1][p[6]] ^ kTables[0][p[7]];
+            }
+            while (n--) c = kTables[0][(c ^ *p++) & 0xFFu] ^ (c >> 8);
+            return c;
+        }
+
+#ifdef MD_CRC32_CLMUL
+        __attribute__((target("pclmul,sse4.1")))
+        inline __m128i load(const unsigned char *q) noexcept {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(q));
+        }
+
+        /// x * k (low and high halves against k's low and high constants), plus 'next'.
+        __attribute__((target("pclmul,sse4.1")))
+        inline __m128i fold(__m128i x, __m128i k, __m128i next) noexcept {
+            const __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+            const __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+            return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+        }
+
+        /**
+         * Fold 'n' bytes (n >= 64, multiple of 16) into the raw register 'c'.
+         * Four 128-bit accumulators are folded 512 bits ahead per block, merged to one, folded 128
+         * bits at a time over the rest, then reduced 128 -> 64 -> 32 (Barrett). Constants are
+         * x^k mod P in the reflected domain, from the paper's appendix.
+         */
+        __attribute__((target("pclmul,sse4.1")))
+        std::uint32_t clmulUpdate(std::uint32_t c, const unsigned char *p, std::size_t n) noexcept {
+            const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+            const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+            const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124);
+            const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+            const __m128i lo32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+            __m128i x1 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(c)));
+            __m128i x2 = load(p + 16);
+            __m128i x3 = load(p + 32);
+            __m128i x4 = load(p + 48);
+            p += 64;
+            n -= 64;
+
+            while (n >= 64) {
+                x1 = fold(x1, k1k2, load(p));
+                x2 = fold(x2, k1k2, load(p + 16));
+                x3 = fold(x3, k1k2, load(p + 32));
+                x4 = fold(x4, k1k2, load(p + 48));
+                p += 64;
+                n -= 64;
+            }
+
+            x1 = fold(x1, k3k4, x2);
+            x1 = fold(x1, k3k4, x3);
+            x1 = fold(x1, k3k4, x4);
+            for (; n >= 16; p += 16, n -= 16) x1 = fold(x1, k3k4, load(p));
+
+            // 128 -> 64 bits
+            __m128i x2r = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+            x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2r);
+            x2r = _mm_srli_si128(x1, 4);
+            x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, lo32), k5, 0x00);
+            x1 = _mm_xor_si128(x1, x2r);
+
+            // Barrett reduction to 32 bits
+            x2r = _mm_clmulepi64_si128(_mm_and_si128(x1, lo32), poly, 0x10);
+            x2r = _mm_clmulepi64_si128(_mm_and_si128(x2r, lo32), poly, 0x00);
+            x1 = _mm_xor_si128(x1, x2r);
+            return static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+        }
+
+        const bool kHasClmul = [] {
+            __builtin_cpu_init(); // may run before libgcc's own cpu init during static initialisation
+            return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+        }();
+#endif
+    }
+
+    std::uint32_t update(std::uint32_t crc, const void *data, std::size_t len) noexcept {
+        const auto *p = static_cast<const unsigned char *>(data);
+        std::uint32_t c = ~crc;
+#ifdef MD_CRC32_CLMUL
+        if (kHasClmul && len >= 64) {
+            const std::size_t body = len & ~std::size_t{15};
+            c = clmulUpdate(c, p, body);
+            p += body;
+            len -= body;
+        }
+#endif
+        return ~tableUpdate(c, p, len);
+    }
+
+    bool accelerated() noexcept {
+#ifdef MD_CRC32_CLMUL
+        return kHasClmul;
+#else
+        return false;
+#endif
+    }
+}
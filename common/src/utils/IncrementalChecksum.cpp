@@ -0,0 +1,136 @@
+#include "utils/IncrementalChecksum.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "utils/Crc32.hpp"
+
+namespace md {
+    namespace {
+        /// Bytes hashed between two checkpoints: long enough for the folding kernel, short enough
+        /// that a change near the top does not rehash much more than its suffix.
+        constexpr std::size_t kCheckpointBytes = 256;
+    }
+
+    void InterleavedCrc32Tracker::invalidate() noexcept {
+        valid_ = false;
+    }
+
+    void InterleavedCrc32Tracker::noteChange(const BookChange &change) noexcept {
+        if (change.touched()) dirtyFrom_ = std::min<std::size_t>(dirtyFrom_, change.shallowest);
+    }
+
+    std::optional<std::uint32_t> InterleavedCrc32Tracker::value(const OrderBook &book, std::size_t topN) {
+        if (!valid_ || topN != topN_) {
+            topN_ = topN;
+            for (std::size_t s = 0; s < 2; ++s) {
+                for (std::size_t i = 0; i < count_[s]; ++i) freeSlots_.push_back(tokens_[s][i].slot);
+                tokens_[s].resize(topN);
+                count_[s] = 0;
+            }
+            scratch_.resize(topN);
+            checkpoints_.clear();
+            dirtyFrom_ = 0;
+        }
+        if (valid_ && dirtyFrom_ >= topN_) return crc_;
+
+        const std::size_t from = std::min({dirtyFrom_, count_[0], count_[1]});
+        valid_ = false;
+        if (!refreshSide_<Side::BID>(book, from, topN) || !refreshSide_<Side::ASK>(book, from, topN))
+            return std::nullopt;
+        rehash_(from);
+
+        dirtyFrom_ = topN_;
+        valid_ = true;
+        return crc_;
+    }
+
+    std::uint32_t InterleavedCrc32Tracker::takeSlot_() {
+        if (freeSlots_.empty()) {
+            text_.emplace_back();
+            return static_cast<std::uint32_t>(text_.size() - 1);
+        }
+        const std::uint32_t slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        return slot;
+    }
+
+    template<Side S>
+    bool InterleavedCrc32Tracker::refreshSide_(const OrderBook &book, std::size_t from, std::size_t topN) {
+        auto &cached = tokens_[S == Side::BID ? 0 : 1];
+        std::size_t &count = count_[S == Side::BID ? 0 : 1];
+        auto better = [](std::int64_t a, std::int64_t b) { return S == Side::BID ? a > b : a < b; };
+
+        std::size_t j = from; // cursor into the cached ranks, same price order as the book
+        std::size_t n = from;
+        bool ok = true;
+        for (; n < topN; ++n) {
+            const BookLevel *lvl = (S == Side::BID) ? book.bid_ptr(n) : book.ask_ptr(n);
+            if (!lvl) break;
+            while (j < count && better(cached[j].tick, lvl->priceTick)) ++j;
+
+            Token &out = scratch_[n];
+            out.tick = lvl->priceTick;
+            out.lot = lvl->quantityLot;
+            if (j < count && cached[j].tick == lvl->priceTick && cached[j].lot == lvl->quantityLot) {
+                out.slot = std::exchange(cached[j].slot, kNoSlot);
+                ++j;
+                continue;
+            }
+            const LevelText *t = (S == Side::BID) ? book.bid_text(n) : book.ask_text(n);
+            if (!t) {
+                ok = false; // text not retained
+                break;
+            }
+            out.slot = takeSlot_();
+            std::string &text = text_[out.slot];
+            text.assign(t->price);
+            text.push_back(':');
+            text.append(t->quantity);
+        }
+
+        for (std::size_t i = from; i < count; ++i)
+            if (cached[i].slot != kNoSlot) freeSlots_.push_back(cached[i].slot);
+        std::copy(scratch_.begin() + static_cast<std::ptrdiff_t>(from),
+                  scratch_.begin() + static_cast<std::ptrdiff_t>(n),
+                  cached.begin() + static_cast<std::ptrdiff_t>(from));
+        count = n;
+        return ok;
+    }
+
+    void InterleavedCrc32Tracker::rehash_(std::size_t from) {
+        while (!checkpoints_.empty() && checkpoints_.back().rank > from) checkpoints_.pop_back();
+        if (checkpoints_.empty()) checkpoints_.push_back({0, 0, 0});
+
+        const Checkpoint start = checkpoints_.back();
+        std::uint32_t crc = start.crc;
+        std::size_t len = start.len;
+
+        std::size_t pos = 0; // bytes pending in buf_
+        auto flush = [&] {
+            crc = crc32::update(crc, buf_.data(), pos);
+            len += pos;
+            pos = 0;
+        };
+        auto append = [&](const Token &tok) {
+            const std::string &text = text_[tok.slot];
+            if (pos + text.size() + 1 > buf_.size()) buf_.resize(pos + text.size() + 1 + kCheckpointBytes);
+            if (len + pos > 0) buf_[pos++] = ':';
+            std::memcpy(buf_.data() + pos, text.data(), text.size());
+            pos += text.size();
+        };
+
+        const std::size_t ranks = std::max(count_[0], count_[1]);
+        for (std::size_t i = start.rank; i < ranks; ++i) {
+            if (pos >= kCheckpointBytes) {
+                flush();
+                checkpoints_.push_back({i, crc, len});
+            }
+            if (i < count_[0]) append(tokens_[0][i]);
+            if (i < count_[1]) append(tokens_[1][i]);
+        }
+        flush();
+        crc_ = crc;
+    }
+}
@@ -22,8 +22,8 @@
 #include "utils/DebugConfigUtils.hpp"
 
 static void print_book_bbo(const md::OrderBook &book) {
-    const Level *bb = book.bid_ptr(0);
-    const Level *ba = book.ask_ptr(0);
+    const BookLevel *bb = book.bid_ptr(0);
+    const BookLevel *ba = book.ask_ptr(0);
     if (!bb || !ba) return;
 
     std::cout << "[BBO] bid=" << bb->priceTick << " qty=" << bb->quantityLot
@@ -88,19 +88,31 @@ int main(int argc, char **argv) {
     // so options.depthLevel should always be set in practice,
     // but keep a safe fallback.
     cfg.depthLevel = options.depthLevel.value_or(400);
+    if (!md::parse_book_kind(options.book_kind, cfg.book.kind)) {
+        spdlog::error("unknown book_kind '{}'. Expected one of: sorted, ladder.", options.book_kind);
+        return 1;
+    }
+    cfg.book.ladder_ticks = static_cast<std::size_t>(options.ladder_ticks);
+    cfg.book.reserve_levels = static_cast<std::size_t>(options.book_reserve_levels);
 
     cfg.ws_host = options.ws_host.value_or("");
     cfg.ws_port = options.ws_port.value_or("");
     cfg.ws_path = options.ws_path.value_or("");
+    cfg.ws_deflate = options.ws_deflate;
+    cfg.ws_connections = options.ws_connections;
+    cfg.ws_alt_hosts = options.ws_alt_hosts;
     cfg.rest_host = options.rest_host.value_or("");
     cfg.rest_port = options.rest_port.value_or("");
     cfg.rest_path = options.rest_path.value_or("");
+    cfg.socket = options.socket;
+    cfg.kernel_rx_timestamps = options.kernel_rx_timestamps;
     cfg.brain_ws_host = options.brain_ws_host.value_or("");
     cfg.brain_ws_port = options.brain_ws_port.value_or("");
     cfg.brain_ws_path = options.brain_ws_path.value_or("");
     cfg.brain_ws_insecure = options.brain_ws_insecure;
     cfg.brain_ws_certfile = options.brain_ws_certfile.value_or("");
     cfg.brain_ws_keyfile  = options.brain_ws_keyfile.value_or("");
+    cfg.brain_ws_deflate = options.brain_ws_deflate;
     cfg.persist_path = options.persist_path.value_or("");
     cfg.persist_book_every_updates = static_cast<std::size_t>(options.persist_book_every_updates);
     cfg.persist_book_top = static_cast<std::size_t>(options.persist_book_top);
@@ -153,17 +165,31 @@ int main(int argc, char **argv) {
     spdlog::info("  venue      = {}", options.venue);
     spdlog::info("  base/quote = {}/{}", cfg.base_ccy, cfg.quote_ccy);
     spdlog::info("  depthLevel = {}", cfg.depthLevel);
+    spdlog::info("  book_kind  = {}{}", md::to_string(cfg.book.kind),
+                 cfg.book.kind == md::BookKind::Ladder
+                     ? " (ladder_ticks=" + std::to_string(cfg.book.ladder_ticks) + ")" : std::string{});
+    spdlog::info("  book_reserve_levels = {}", cfg.book.reserve_levels);
     spdlog::info("  ws_sym     = {}", ws_sym);
     spdlog::info("  rest_sym   = {}", rest_sym);
     spdlog::info("  cfg.symbol = {}", cfg.symbol);
     spdlog::info("  ws_host    = {}", cfg.ws_host.empty() ? "<default>" : cfg.ws_host);
     spdlog::info("  ws_port    = {}", cfg.ws_port.empty() ? "<default>" : cfg.ws_port);
     spdlog::info("  ws_path    = {}", cfg.ws_path.empty() ? "<default>" : cfg.ws_path);
+    spdlog::info("  ws_deflate = {}", md::describe(cfg.ws_deflate));
+    if (cfg.ws_connections > 1) {
+        std::string alt;
+        for (const auto &h : cfg.ws_alt_hosts) alt += (alt.empty() ? "" : ",") + (h.empty() ? "<same>" : h);
+        spdlog::info("  ws_connections = {} (alt hosts: {})", cfg.ws_connections, alt.empty() ? "<none>" : alt);
+    }
     spdlog::info("  rest_host  = {}", cfg.rest_host.empty() ? "<default>" : cfg.rest_host);
     spdlog::info("  rest_port  = {}", cfg.rest_port.empty() ? "<default>" : cfg.rest_port);
     spdlog::info("  rest_path  = {}", cfg.rest_path.empty() ? "<default>" : cfg.rest_path);
+    spdlog::info("  socket     = {}", md::describe(cfg.socket));
+    spdlog::info("  kernel_rx_timestamps = {}", cfg.kernel_rx_timestamps ? "on" : "off");
     spdlog::info("  brain_ws   = {}", cfg.brain_ws_host.empty()
         ? "<disabled>" : (cfg.brain_ws_host + ":" + cfg.brain_ws_port + cfg.brain_ws_path));
+    if (!cfg.brain_ws_host.empty())
+        spdlog::info("  brain_ws_deflate = {}", md::describe(cfg.brain_ws_deflate));
     spdlog::info("  persist    = {}", cfg.persist_path.empty() ? "<disabled>" : cfg.persist_path);
     spdlog::info("  persist_book_every_updates = {}", cfg.persist_book_every_updates);
     spdlog::info("  persist_book_top           = {}", cfg.persist_book_top);
@@ -173,7 +199,7 @@ int main(int argc, char **argv) {
     // ---------------------------------------------------------------------
     boost::asio::io_context ioc;
 
-    auto h = std::make_unique<md::GenericFeedHandler>(ioc);
+    auto h = md::makeFeedHandler(cfg.venue_name, ioc);
 
     auto st = h->init(cfg);
     spdlog::info("[MAIN] init = {}", (st == md::FeedOpResult::OK ? "OK" : "ERROR"));
@@ -0,0 +1,169 @@
+/**
+ * Micro-benchmark: venue adapter parsing over recorded frames (pop/bench/fixtures).
+ * Build with -DPOP_BUILD_BENCH=ON (add -DPOP_COUNT_ALLOCS=ON for the allocs/msg column),
+ * run ./pop/pop_bench [iterations] [fixtures dir].
+ * Cases:
+ * - ws incremental / ws snapshot / ws control: classifyAndParse on the frames of that kind, into
+ *   reused scratch messages like GenericFeedHandler does (the kind is read in the same scan)
+ * - rest snapshot: parseSnapshot on the REST body (Binance, KuCoin)
+ * - decimal: parseDecimalToScaled (SWAR dispatch) vs parseDecimalToScaledScalar over every price /
+ *   quantity token of the fixtures
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "md/VenueAdapter.hpp"
+#include "orderbook/OrderBookUtils.hpp"
+#include "utils/AllocCounter.hpp"
+
+#ifndef POP_BENCH_FIXTURES_DIR
+#define POP_BENCH_FIXTURES_DIR "pop/bench/fixtures"
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Result {
+        double ns;
+        double allocs;
+    };
+
+    std::vector<std::string> readLines(const std::string &path) {
+        std::vector<std::string> out;
+        std::ifstream in(path);
+        for (std::string line; std::getline(in, line);)
+            if (!line.empty()) out.push_back(std::move(line));
+        return out;
+    }
+
+    std::string readFile(const std::string &path) {
+        std::ifstream in(path);
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    /// 'fn' once per item per iteration, after one untimed warm-up pass (sizes the scratch messages).
+    template<typename T, typename Fn>
+    Result run(const std::vector<T> &items, std::size_t iterations, Fn &&fn) {
+        for (const T &item: items) fn(item);
+        const std::uint64_t a0 = md::alloc::threadCount();
+        const auto t0 = Clock::now();
+        for (std::size_t it = 0; it < iterations; ++it)
+            for (const T &item: items) fn(item);
+        const auto t1 = Clock::now();
+        const double n = static_cast<double>(iterations * items.size());
+        return {std::chrono::duration<double, std::nano>(t1 - t0).count() / n,
+                static_cast<double>(md::alloc::threadCount() - a0) / n};
+    }
+
+    void report(const char *venue, const char *name, std::size_t count, const Result &r) {
+        if constexpr (md::alloc::kCounting) {
+            std::printf("%-8s %-16s %6zu %11.1f ns %10.2f\n", venue, name, count, r.ns, r.allocs);
+        } else {
+            std::printf("%-8s %-16s %6zu %11.1f ns %10s\n", venue, name, count, r.ns, "-");
+        }
+    }
+
+    void collectTokens(const std::vector<Level> &levels, std::vector<std::string> &tokens) {
+        for (const Level &l: levels) {
+            tokens.emplace_back(l.price);
+            tokens.emplace_back(l.quantity);
+        }
+    }
+
+    template<typename Adapter>
+    void benchVenue(const char *venue, const std::string &dir, std::size_t iterations,
+                    std::vector<std::string> &tokens, bool &ok) {
+        const Adapter adapter{};
+        GenericSnapshotFormat snap;
+        GenericIncrementalFormat inc;
+
+        // Sort the recorded session by frame kind; every frame must be recognised.
+        std::vector<std::string> incrementals, snapshots, control;
+        const std::vector<std::string> frames = readLines(dir + "/" + venue + "_ws.jsonl");
+        if (frames.empty()) {
+            std::printf("%-8s missing %s_ws.jsonl\n", venue, venue);
+            ok = false;
+            return;
+        }
+        for (const std::string &frame: frames) {
+            switch (adapter.classifyAndParse(frame, snap, inc)) {
+            case md::FrameKind::Incremental:
+                collectTokens(inc.bids, tokens);
+                collectTokens(inc.asks, tokens);
+                incrementals.push_back(frame);
+                break;
+            case md::FrameKind::Snapshot:
+                collectTokens(snap.bids, tokens);
+                collectTokens(snap.asks, tokens);
+                snapshots.push_back(frame);
+                break;
+            case md::FrameKind::Pong:
+            case md::FrameKind::SubscribeAck:
+                control.push_back(frame);
+                break;
+            case md::FrameKind::Ignore:
+                std::printf("%-8s unrecognised frame: %.80s\n", venue, frame.c_str());
+                ok = false;
+                break;
+            }
+        }
+
+        auto parse = [&](const std::string &frame) { return adapter.classifyAndParse(frame, snap, inc); };
+        if (!incrementals.empty()) report(venue, "ws incremental", incrementals.size(), run(incrementals, iterations, parse));
+        if (!snapshots.empty()) report(venue, "ws snapshot", snapshots.size(), run(snapshots, iterations, parse));
+        if (!control.empty()) report(venue, "ws control", control.size(), run(control, iterations, parse));
+
+        const std::string body = readFile(dir + "/" + venue + "_rest_snapshot.json");
+        if (body.empty()) return;
+        if (!adapter.parseSnapshot(body, snap)) {
+            std::printf("%-8s rest snapshot does not parse\n", venue);
+            ok = false;
+            return;
+        }
+        collectTokens(snap.bids, tokens);
+        collectTokens(snap.asks, tokens);
+        const std::vector<std::string> bodies{body};
+        report(venue, "rest snapshot", 1, run(bodies, iterations, [&](const std::string &b) {
+            return adapter.parseSnapshot(b, snap);
+        }));
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    const std::string dir = argc > 2 ? argv[2] : POP_BENCH_FIXTURES_DIR;
+
+    std::vector<std::string> tokens;
+    bool ok = true;
+
+    std::printf("%-8s %-16s %6s %14s %10s\n", "venue", "case", "msgs", "per msg", "allocs/msg");
+    benchVenue<md::BinanceAdapter>("binance", dir, iterations, tokens, ok);
+    benchVenue<md::OKXAdapter>("okx", dir, iterations, tokens, ok);
+    benchVenue<md::BitgetAdapter>("bitget", dir, iterations, tokens, ok);
+    benchVenue<md::BybitAdapter>("bybit", dir, iterations, tokens, ok);
+    benchVenue<md::KucoinAdapter>("kucoin", dir, iterations, tokens, ok);
+
+    // Scales as the adapters do (scanLevels: 100 / 1000), alternating price and quantity tokens.
+    std::int64_t sink = 0;
+    std::size_t i = 0;
+    auto scale = [&i] { return (i++ & 1) ? std::int64_t{1000} : std::int64_t{100}; };
+    report("all", "decimal swar", tokens.size(), run(tokens, iterations, [&](const std::string &t) {
+        sink += md::parseDecimalToScaled(t, scale());
+    }));
+    i = 0;
+    report("all", "decimal scalar", tokens.size(), run(tokens, iterations, [&](const std::string &t) {
+        sink += md::parseDecimalToScaledScalar(t, scale());
+    }));
+
+    std::printf("sink=%lld\n", static_cast<long long>(sink));
+    return ok ? 0 : 1;
+}
@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <optional>
 #include <ranges>
+#include <sstream>
+#include <vector>
 #include <cctype>
 
 struct CmdOptions {
@@ -16,18 +18,27 @@ struct CmdOptions {
     std::string base; // --base BTC
     std::string quote; // --quote USDT
     std::optional<int> depthLevel;
+    std::string book_kind{"sorted"}; // sorted | ladder
+    int ladder_ticks{8192};          // ladder ring width in ticks
+    int book_reserve_levels{0};      // levels kept beyond depthLevel (not published)
     std::optional<std::string> ws_host; // override or std::nullopt
     std::optional<std::string> ws_port; // override or std::nullopt
     std::optional<std::string> ws_path; // override or std::nullopt
+    md::WsDeflateOptions ws_deflate{}; // permessage-deflate towards the venue
+    int ws_connections{1}; // redundant venue WS connections
+    std::vector<std::string> ws_alt_hosts; // hosts for the extra connections
     std::optional<std::string> rest_host; // override or std::nullopt
     std::optional<std::string> rest_port; // override or std::nullopt
     std::optional<std::string> rest_path; // override or std::nullopt
+    md::SocketOptions socket{}; // kernel socket options for every outbound connection
+    bool kernel_rx_timestamps{false}; // SO_TIMESTAMPNS on the venue socket
     std::optional<std::string> brain_ws_host; // outbound brain WS host (optional)
     std::optional<std::string> brain_ws_port; // outbound brain WS port (optional)
     std::optional<std::string> brain_ws_path; // outbound brain WS path (optional)
     bool brain_ws_insecure{false}; // disable TLS verification (local testing)
     std::optional<std::string> brain_ws_certfile; // F1: mTLS client cert PEM
     std::optional<std::string> brain_ws_keyfile;  // F1: mTLS client key PEM
+    md::WsDeflateOptions brain_ws_deflate{}; // permessage-deflate towards brain
     std::optional<std::string> persist_path; // optional JSONL persistence file
     std::optional<std::string> log_path; // optional process log file path
     int persist_book_every_updates{0}; // 0 = disabled
@@ -80,18 +91,50 @@ inline bool parse_cmdline(int argc, char **argv, CmdOptions &out) {
              "Quote asset, e.g. USDT")
             ("depthLevel,dl", po::value<int>()->default_value(400),
              "Orderbook depth; required or defaults")
+            ("book_kind", po::value<std::string>()->default_value("sorted"),
+             "Order book layout: sorted (contiguous vector) | ladder (tick-indexed ring around the touch)")
+            ("ladder_ticks", po::value<int>()->default_value(8192),
+             "Ladder book window width in ticks (rounded up to a power of two)")
+            ("book_reserve_levels", po::value<int>()->default_value(0),
+             "Levels kept beyond depthLevel (not published) so the book refills after cancels near the top")
             ("ws_host", po::value<std::string>(),
              "Optional WebSocket host override")
             ("ws_port", po::value<std::string>(),
              "Optional WebSocket port override")
             ("ws_path", po::value<std::string>(),
              "Optional WebSocket path override")
+            ("ws_deflate", po::bool_switch()->default_value(false),
+             "Offer permessage-deflate to the venue (used only if the venue accepts it)")
+            ("ws_deflate_window_bits", po::value<int>()->default_value(15),
+             "Venue WS: permessage-deflate LZ77 window bits, 9..15")
+            ("ws_deflate_no_context_takeover", po::bool_switch()->default_value(false),
+             "Venue WS: reset the deflate context per message (less memory, worse ratio)")
+            ("ws_deflate_level", po::value<int>()->default_value(6),
+             "Venue WS: compression level for frames we send, 0..9 (0 = send uncompressed)")
+            ("ws_connections", po::value<int>()->default_value(1),
+             "Concurrent venue WebSocket connections, 1..8; each update is applied from the first to deliver it")
+            ("ws_alt_hosts", po::value<std::string>(),
+             "Comma-separated hosts for connections 2.. (empty entry = same host as the first)")
             ("rest_host", po::value<std::string>(),
              "Optional REST host override")
             ("rest_port", po::value<std::string>(),
              "Optional REST port override")
             ("rest_path", po::value<std::string>(),
              "Optional REST path override")
+            ("sock_nodelay", po::value<bool>()->default_value(true),
+             "TCP_NODELAY on venue WS, REST and brain sockets")
+            ("sock_rcvbuf", po::value<int>()->default_value(0),
+             "SO_RCVBUF bytes (0 = kernel default / autotuning)")
+            ("sock_sndbuf", po::value<int>()->default_value(0),
+             "SO_SNDBUF bytes (0 = kernel default / autotuning)")
+            ("sock_busy_poll_us", po::value<int>()->default_value(0),
+             "SO_BUSY_POLL microseconds (Linux; 0 = off)")
+            ("sock_quickack", po::value<bool>()->default_value(false),
+             "TCP_QUICKACK, re-armed after every WebSocket read (Linux)")
+            ("sock_tos", po::value<int>()->default_value(-1),
+             "IP TOS / traffic class byte (-1 = leave)")
+            ("kernel_rx_timestamps", po::bool_switch()->default_value(false),
+             "Record the kernel receive time of venue frames (SO_TIMESTAMPNS, Linux) as ts_recv_kernel_ns")
             ("brain_ws_host", po::value<std::string>(),
              "Optional brain WebSocket host (PoP publishes normalized updates)")
             ("brain_ws_port", po::value<std::string>(),
@@ -104,12 +147,20 @@ inline bool parse_cmdline(int argc, char **argv, CmdOptions &out) {
              "F1: mTLS client certificate PEM file for PoP->brain connection")
             ("brain_ws_keyfile", po::value<std::string>(),
              "F1: mTLS client private key PEM file for PoP->brain connection")
+            ("brain_ws_deflate", po::bool_switch()->default_value(false),
+             "Offer permessage-deflate to brain (used only if brain runs with --ws-deflate)")
+            ("brain_ws_deflate_window_bits", po::value<int>()->default_value(15),
+             "Brain WS: permessage-deflate LZ77 window bits, 9..15")
+            ("brain_ws_deflate_no_context_takeover", po::bool_switch()->default_value(false),
+             "Brain WS: reset the deflate context per message (less memory, worse ratio)")
+            ("brain_ws_deflate_level", po::value<int>()->default_value(6),
+             "Brain WS: compression level for published frames, 0..9 (0 = send uncompressed)")
             ("persist_path", po::value<std::string>(),
              "Optional persistence output file path (JSONL)")
             ("log_path", po::value<std::string>(),
              "Optional process log output file path (.log is appended if missing)")
             ("persist_book_every_updates", po::value<int>()->default_value(0),
-             "Persist orderbook checkpoint every N applied updates (0 disables)")
+             "Persist orderbook checkpoint every N applied updates, skipped if the top N is unchanged (0 disables)")
             ("persist_book_top", po::value<int>()->default_value(50),
              "Orderbook checkpoint top N levels per side")
             ("rest_timeout_ms", po::value<int>()->default_value(8000),
@@ -119,7 +170,7 @@ inline bool parse_cmdline(int argc, char **argv, CmdOptions &out) {
             ("validate_every", po::value<int>()->default_value(0),
              "C3: call OrderBook::validate() every N applied updates (0=disabled)")
             ("require_checksum", po::bool_switch()->default_value(false),
-             "C5: resync if checksum field is absent on a checksum-capable venue")
+             "C5: resync if checksum field is absent on a checksum-capable venue; enables opt-in checksums (Bitget)")
             ("log_level", po::value<std::string>()->default_value("info"),
              "D1: log verbosity: debug | info | warn | error")
             ("debug", po::bool_switch()->default_value(false),
@@ -184,18 +235,41 @@ inline bool parse_cmdline(int argc, char **argv, CmdOptions &out) {
     out.base = vm["base"].as<std::string>();
     out.quote = vm["quote"].as<std::string>();
     out.depthLevel = vm["depthLevel"].as<int>();
+    out.book_kind = vm["book_kind"].as<std::string>();
+    out.ladder_ticks = std::max(64, vm["ladder_ticks"].as<int>());
+    out.book_reserve_levels = std::max(0, vm["book_reserve_levels"].as<int>());
     if (vm.count("ws_host")) out.ws_host = vm["ws_host"].as<std::string>();
     if (vm.count("ws_port")) out.ws_port = vm["ws_port"].as<std::string>();
     if (vm.count("ws_path")) out.ws_path = vm["ws_path"].as<std::string>();
+    out.ws_deflate.enabled = vm["ws_deflate"].as<bool>();
+    out.ws_deflate.window_bits = vm["ws_deflate_window_bits"].as<int>();
+    out.ws_deflate.no_context_takeover = vm["ws_deflate_no_context_takeover"].as<bool>();
+    out.ws_deflate.level = vm["ws_deflate_level"].as<int>();
+    out.ws_connections = std::clamp(vm["ws_connections"].as<int>(), 1, 8);
+    if (vm.count("ws_alt_hosts")) {
+        std::stringstream hosts(vm["ws_alt_hosts"].as<std::string>());
+        for (std::string h; std::getline(hosts, h, ',');) out.ws_alt_hosts.push_back(h);
+    }
     if (vm.count("rest_host")) out.rest_host = vm["rest_host"].as<std::string>();
     if (vm.count("rest_port")) out.rest_port = vm["rest_port"].as<std::string>();
     if (vm.count("rest_path")) out.rest_path = vm["rest_path"].as<std::string>();
+    out.socket.tcp_nodelay = vm["sock_nodelay"].as<bool>();
+    out.socket.rcvbuf = std::max(0, vm["sock_rcvbuf"].as<int>());
+    out.socket.sndbuf = std::max(0, vm["sock_sndbuf"].as<int>());
+    out.socket.busy_poll_us = std::max(0, vm["sock_busy_poll_us"].as<int>());
+    out.socket.quickack = vm["sock_quickack"].as<bool>();
+    out.socket.tos = std::clamp(vm["sock_tos"].as<int>(), -1, 255);
+    out.kernel_rx_timestamps = vm["kernel_rx_timestamps"].as<bool>();
     if (vm.count("brain_ws_host")) out.brain_ws_host = vm["brain_ws_host"].as<std::string>();
     if (vm.count("brain_ws_port")) out.brain_ws_port = vm["brain_ws_port"].as<std::string>();
     if (vm.count("brain_ws_path")) out.brain_ws_path = vm["brain_ws_path"].as<std::string>();
     out.brain_ws_insecure = vm["brain_ws_insecure"].as<bool>();
     if (vm.count("brain_ws_certfile")) out.brain_ws_certfile = vm["brain_ws_certfile"].as<std::string>();
     if (vm.count("brain_ws_keyfile"))  out.brain_ws_keyfile  = vm["brain_ws_keyfile"].as<std::string>();
+    out.brain_ws_deflate.enabled = vm["brain_ws_deflate"].as<bool>();
+    out.brain_ws_deflate.window_bits = vm["brain_ws_deflate_window_bits"].as<int>();
+    out.brain_ws_deflate.no_context_takeover = vm["brain_ws_deflate_no_context_takeover"].as<bool>();
+    out.brain_ws_deflate.level = vm["brain_ws_deflate_level"].as<int>();
     if (vm.count("persist_path")) out.persist_path = vm["persist_path"].as<std::string>();
     if (vm.count("log_path")) out.log_path = vm["log_path"].as<std::string>();
     out.persist_book_every_updates = std::max(0, vm["persist_book_every_updates"].as<int>());
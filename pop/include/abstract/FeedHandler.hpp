@@ -2,6 +2,11 @@
 
 #include <boost/asio/io_context.hpp>  /// External event loop
 #include <string>
+#include <vector>
+
+#include "connection_handler/SocketOptions.hpp"
+#include "connection_handler/WsDeflate.hpp"
+#include "orderbook/OrderBook.hpp"
 
 namespace md {
     /**
@@ -46,11 +51,17 @@ namespace md {
         std::string ws_host; ///< optional override, "" = default
         std::string ws_port; ///< optional override, "" = default
         std::string ws_path; ///< optional override, "" = default
+        WsDeflateOptions ws_deflate{}; ///< permessage-deflate offered to the venue
+        int ws_connections{1}; ///< concurrent venue WS legs; > 1 applies each seq from the first leg to deliver it
+        std::vector<std::string> ws_alt_hosts; ///< host for legs 1.. (entry i -> leg i+1), "" / missing = ws host
 
         std::string rest_host; ///< optional override, "" = default
         std::string rest_port; ///< optional override, "" = default
         std::string rest_path; ///< optional override, "" = default
 
+        SocketOptions socket{}; ///< kernel socket options for the venue WS, REST and brain connections
+        bool kernel_rx_timestamps{false}; ///< stamp venue frames with the kernel receive time (SO_TIMESTAMPNS)
+
         // Optional: PoP -> brain outbound websocket (central aggregation).
         // Disabled when brain_ws_host is empty.
         std::string brain_ws_host;
@@ -61,6 +72,7 @@ namespace md {
         // Both must be set to enable mTLS; if either is empty, plain TLS is used.
         std::string brain_ws_certfile;
         std::string brain_ws_keyfile;
+        WsDeflateOptions brain_ws_deflate{}; ///< permessage-deflate offered to brain
 
         std::string persist_path; ///< optional event persistence file path, "" = disabled
         std::size_t persist_book_every_updates{0}; ///< 0 = disabled
@@ -78,6 +90,9 @@ namespace md {
         bool require_checksum{false};
 
         size_t depthLevel{0};
+
+        /// Book storage layout (sorted vector vs tick ladder) and its sizing.
+        BookOptions book{};
     };
 
     /**
@@ -16,6 +16,8 @@
 #include <memory>
 #include <string>
 
+#include "connection_handler/SocketOptions.hpp"
+
 namespace md {
     class RestClient : public std::enable_shared_from_this<RestClient> {
     public:
@@ -61,6 +63,9 @@ namespace md {
             max_body_bytes_ = max_body_bytes;
         }
 
+        /// Kernel socket options applied after each new TCP connection (reused connections keep theirs).
+        void set_socket_options(const SocketOptions &opts) { sock_opts_ = opts; }
+
         /// Cancel any in-flight request and complete callback with operation_aborted.
         /// Safe to call from any thread.
         void cancel();
@@ -155,6 +160,8 @@ namespace md {
 
         int last_http_status_{0};
 
+        SocketOptions sock_opts_{};
+
         LogFn logger_;
     };
 } // namespace md
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "md/FrameScanner.hpp"
+#include "orderbook/BookLevel.hpp"
+#include "orderbook/OrderBookUtils.hpp"
+
+/**
+ * Notes:
+ * - Every venue wraps the same book payload (sequence ids, optional checksum, bid/ask level arrays)
+ *   in a slightly different envelope. BookFrameLayout names those fields; each adapter declares its
+ *   layouts as constexpr, and scanBookFrame walks a frame once along them (FrameScanner, no DOM).
+ * - The walker only extracts; what the ids mean (first/last/prev sequence) stays in the adapter.
+ * - Header-only and inline so that, with a constexpr layout, the key compares fold into the
+ *   adapter's parse function.
+ */
+namespace md {
+    /**
+     * Field names of one venue frame type. Empty name = field not present for this venue.
+     * Envelope: { <tagKey>: "...", <subjectKey>: "...", <eventKey>: ..., <dataKey>: <payload> or [<payload>, ...] }
+     * Payload:  { <seq keys>..., <checksumKey>: n, <levelsKey>: { <bidsKey>: [...], <asksKey>: [...] } }
+     * With an empty dataKey the payload fields sit in the envelope itself; with an empty levelsKey
+     * the level arrays sit directly in the payload.
+     */
+    struct BookFrameLayout {
+        std::string_view tagKey{};
+        std::string_view subjectKey{};
+        std::string_view eventKey{}; ///< control-frame discriminator (subscribe ack, pong); any scalar
+
+        std::string_view dataKey{};
+        bool dataIsArray{false}; ///< payload is data[0]
+
+        std::string_view firstSeqKey{};
+        std::string_view seqKey{};
+        std::string_view prevSeqKey{};
+        std::string_view checksumKey{}; ///< also accepted in the envelope; the payload's value wins
+
+        std::string_view levelsKey{};
+        std::string_view bidsKey{};
+        std::string_view asksKey{};
+    };
+
+    /**
+     * Scalars pulled out of one frame; views point into the frame.
+     */
+    struct BookFrame {
+        std::string_view tag;
+        std::string_view subject;
+        std::string_view event;
+        std::optional<std::int64_t> firstSeq;
+        std::optional<std::int64_t> seq;
+        std::optional<std::int64_t> prevSeq;
+        std::optional<std::int64_t> checksum;
+        bool hasBids{false};
+        bool hasAsks{false};
+    };
+
+    /// [[price, qty, ...], ...] -> levels; price/qty may be strings or bare numbers, extra columns are skipped.
+    /// The text is collected first and scaled in one batch (scaleLevels) once the array is complete.
+    /// Level text is left as views into the frame: nothing is copied per level.
+    inline bool scanLevels(FrameScanner &sc, std::vector<Level> &out) {
+        const std::size_t first = out.size();
+        const bool ok = sc.array([&] {
+            std::string_view px, qt;
+            if (!sc.consume('[') || !sc.scalar(px) || !sc.consume(',') || !sc.scalar(qt)) return false;
+            while (sc.consume(',')) if (!sc.skipValue()) return false;
+            if (!sc.consume(']')) return false;
+            out.push_back(Level{0, 0, px, qt});
+            return true;
+        });
+        if (ok) scaleLevels(std::span<Level>(out).subspan(first), 100, 1000);
+        return ok;
+    }
+
+    /**
+     * Walk 'msg' along 'L': scalars go to 'f', levels are appended to 'bids' / 'asks'.
+     * Returns false on malformed JSON or a malformed decimal; presence checks are left to the caller.
+     */
+    inline bool scanBookFrame(std::string_view msg, const BookFrameLayout &L, BookFrame &f,
+                              std::vector<Level> &bids, std::vector<Level> &asks) {
+        FrameScanner sc(msg);
+        std::optional<std::int64_t> envelopeChecksum;
+
+        auto int64Field = [&sc](std::optional<std::int64_t> &out) {
+            std::int64_t v = 0;
+            if (!sc.int64(v)) return false;
+            out = v;
+            return true;
+        };
+        auto levelMember = [&](std::string_view key) {
+            if (!L.bidsKey.empty() && key == L.bidsKey) return f.hasBids = scanLevels(sc, bids);
+            if (!L.asksKey.empty() && key == L.asksKey) return f.hasAsks = scanLevels(sc, asks);
+            return sc.skipValue();
+        };
+        auto payloadMember = [&](std::string_view key) {
+            if (!L.seqKey.empty() && key == L.seqKey) return int64Field(f.seq);
+            if (!L.firstSeqKey.empty() && key == L.firstSeqKey) return int64Field(f.firstSeq);
+            if (!L.prevSeqKey.empty() && key == L.prevSeqKey) return int64Field(f.prevSeq);
+            if (!L.checksumKey.empty() && key == L.checksumKey) return int64Field(f.checksum);
+            if (L.levelsKey.empty()) return levelMember(key);
+            if (key == L.levelsKey) return sc.object(levelMember);
+            return sc.skipValue();
+        };
+        auto payload = [&] { return sc.object(payloadMember); };
+
+        try {
+            const bool ok = sc.object([&](std::string_view key) {
+                if (!L.tagKey.empty() && key == L.tagKey) return sc.string(f.tag);
+                if (!L.subjectKey.empty() && key == L.subjectKey) return sc.string(f.subject);
+                if (!L.eventKey.empty() && key == L.eventKey) return sc.scalar(f.event);
+                if (L.dataKey.empty()) return payloadMember(key);
+                if (key == L.dataKey) {
+                    if (!L.dataIsArray) return payload();
+                    bool first = true;
+                    return sc.array([&] {
+                        if (!first) return sc.skipValue();
+                        first = false;
+                        return payload();
+                    });
+                }
+                if (!L.checksumKey.empty() && key == L.checksumKey) return int64Field(envelopeChecksum);
+                return sc.skipValue();
+            });
+            if (!ok) return false;
+        } catch (const std::invalid_argument &) {
+            return false; // malformed decimal
+        }
+
+        if (!f.checksum) f.checksum = envelopeChecksum;
+        return true;
+    }
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+/**
+ * Notes:
+ * - Forward-only cursor over one JSON frame: the caller walks the structure it expects and pulls the
+ *   fields it needs, everything else is skipped without being materialised (no DOM, no allocation).
+ * - Strings come back as views into the frame (raw, escapes are not decoded): fine for the numeric
+ *   strings and ASCII tags venues send, not for free text.
+ * - Every call returns false on malformed or unexpected input; the cursor is then unusable and the
+ *   frame should be dropped (same outcome as a failed json::parse).
+ */
+namespace md {
+    class FrameScanner {
+    public:
+        explicit FrameScanner(std::string_view frame) noexcept
+            : p(frame.data()), end(frame.data() + frame.size()) {
+        }
+
+        /// Skip whitespace; true if the next character is 'c' (not consumed).
+        [[nodiscard]] bool peek(char c) noexcept {
+            skipWs();
+            return p < end && *p == c;
+        }
+
+        /// Skip whitespace and consume 'c'.
+        bool consume(char c) noexcept {
+            if (!peek(c)) return false;
+            ++p;
+            return true;
+        }
+
+        /// "..." -> raw content view.
+        bool string(std::string_view &out) noexcept {
+            if (!consume('"')) return false;
+            const char *b = p;
+            while (p < end && *p != '"') {
+                if (*p == '\\' && p + 1 < end) ++p;
+                ++p;
+            }
+            if (p >= end) return false;
+            out = std::string_view(b, static_cast<std::size_t>(p - b));
+            ++p;
+            return true;
+        }
+
+        /// Unsigned integer, bare or quoted (some venues send sequence ids as strings).
+        bool uint64(std::uint64_t &out) noexcept {
+            skipWs();
+            const bool quoted = (p < end && *p == '"');
+            if (quoted) ++p;
+            std::uint64_t v = 0;
+            if (!digits(v)) return false;
+            if (quoted && !consume('"')) return false;
+            out = v;
+            return true;
+        }
+
+        /// Signed integer, bare or quoted.
+        bool int64(std::int64_t &out) noexcept {
+            skipWs();
+            const bool quoted = (p < end && *p == '"');
+            if (quoted) ++p;
+            const bool negative = (p < end && *p == '-');
+            if (negative) ++p;
+            std::uint64_t v = 0;
+            if (!digits(v)) return false;
+            /// magnitude limit: 2^63 - 1, or 2^63 for a negative value
+            constexpr std::uint64_t maxPositive = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+            if (v > maxPositive + (negative ? 1 : 0)) return false;
+            if (quoted && !consume('"')) return false;
+            out = negative ? static_cast<std::int64_t>(0 - v) : static_cast<std::int64_t>(v);
+            return true;
+        }
+
+        /// String content or a bare scalar token (number / true / false / null), as a view.
+        bool scalar(std::string_view &out) noexcept {
+            if (peek('"')) return string(out);
+            if (peek('{') || peek('[')) return false;
+            const char *b = p;
+            if (!skipValue()) return false;
+            out = std::string_view(b, static_cast<std::size_t>(p - b));
+            return true;
+        }
+
+        /// Skip one value of any type (nested objects/arrays included).
+        bool skipValue() noexcept {
+            skipWs();
+            if (p >= end) return false;
+            if (*p == '"') {
+                std::string_view ignored;
+                return string(ignored);
+            }
+            if (*p == '{' || *p == '[') {
+                std::size_t depth = 0;
+                while (p < end) {
+                    const char c = *p;
+                    if (c == '"') {
+                        std::string_view ignored;
+                        if (!string(ignored)) return false;
+                        continue;
+                    }
+                    ++p;
+                    if (c == '{' || c == '[') ++depth;
+                    else if ((c == '}' || c == ']') && --depth == 0) return true;
+                }
+                return false;
+            }
+            /// number / true / false / null
+            const char *b = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ']' && !isWs(*p)) ++p;
+            return p != b;
+        }
+
+        /**
+         * Walk an object: member(key) is called for every key and must consume its value
+         * (skipValue() for keys it does not need); returning false aborts the walk.
+         */
+        template<typename Member>
+        bool object(Member &&member) {
+            if (!consume('{')) return false;
+            if (consume('}')) return true;
+            do {
+                std::string_view key;
+                if (!string(key) || !consume(':')) return false;
+                if (!member(key)) return false;
+            } while (consume(','));
+            return consume('}');
+        }
+
+        /// Walk an array: element() is called per element and must consume it.
+        template<typename Element>
+        bool array(Element &&element) {
+            if (!consume('[')) return false;
+            if (consume(']')) return true;
+            do {
+                if (!element()) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+
+    private:
+        static constexpr bool isWs(char c) noexcept { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+        void skipWs() noexcept {
+            while (p < end && isWs(*p)) ++p;
+        }
+
+        /// One or more decimal digits into 'v'; false if there are none or the value overflows 64 bits.
+        bool digits(std::uint64_t &v) noexcept {
+            if (p >= end || *p < '0' || *p > '9') return false;
+            constexpr std::uint64_t maxValue = std::numeric_limits<std::uint64_t>::max();
+            v = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                const auto d = static_cast<std::uint64_t>(*p++ - '0');
+                if (v > (maxValue - d) / 10) return false;
+                v = v * 10 + d;
+            }
+            return true;
+        }
+
+        const char *p;
+        const char *end;
+    };
+}
@@ -3,10 +3,10 @@
 #include <boost/asio/io_context.hpp>
 #include <deque>
 #include <memory>
-#include <variant>
 #include <atomic>
 #include <string_view>
 #include <cstdint>
+#include <vector>
 
 #include "abstract/FeedHandler.hpp"
 #include "connection_handler/WsClient.hpp"
@@ -33,11 +33,20 @@ namespace md {
      *  - one instance manages exactly one `(venue, symbol)` feed
      *
      * High-level flow:
-     *  1. `init(cfg)` selects the adapter and resolves cold-path runtime data.
+     *  1. `init(cfg)` resolves cold-path runtime data (endpoints, frames, caps) from the adapter.
      *  2. `start()` connects WS directly or performs venue bootstrap first.
      *  3. snapshot/incremental events are normalized and applied to the controller.
      *  4. if continuity/checksum/watchdog fails, `restartSync()` resets local state and reconnects.
+     *
+     * Redundant connections (`ws_connections > 1`): every leg subscribes to the same stream and each
+     * sequence number is applied from whichever leg delivers it first; later copies are dropped by
+     * `last_seq`. A leg that drops while another is open reconnects on its own without a resync.
+     *
+     * The adapter is a template parameter, so its classify/parse calls are direct (inlinable) calls
+     * in the message loop. Instantiated for every adapter in GenericFeedHandler.cpp; pick one at
+     * startup with `makeFeedHandler()`.
      */
+    template<typename Adapter>
     class GenericFeedHandler final : public IVenueFeedHandler {
     public:
         /// Construct the handler on an externally owned `io_context`.
@@ -63,11 +72,6 @@ namespace md {
         FeedOpResult stop() override;
 
     private:
-        /// Concrete adapter selected from `FeedHandlerConfig::venue_name`.
-        using AnyAdapter = std::variant<BinanceAdapter, OKXAdapter, BitgetAdapter, BybitAdapter, KucoinAdapter>;
-
-        static AnyAdapter makeAdapter(VenueId v);
-
         /**
          * Runtime values resolved once during `init()`.
          *
@@ -89,6 +93,30 @@ namespace md {
             int ws_ping_interval_ms{0}; ///< app-level websocket ping cadence
             int ws_ping_timeout_ms{0}; ///< venue-provided ping timeout hint if available
             int ws_stale_after_ms{0}; ///< no-message threshold before forced resync
+
+            bool arbitrate{false}; ///< more than one leg: first-arrival arbitration by last_seq
+        };
+
+        /**
+         * One venue websocket connection. All legs carry the same stream; leg 0 uses the resolved
+         * endpoint, the others may use an alternate host.
+         */
+        struct WsLeg {
+            explicit WsLeg(boost::asio::io_context &ioc) : reconnect_timer(ioc) {
+            }
+
+            std::shared_ptr<WsClient> ws;
+            EndPoint ep;
+            bool active{false}; ///< connect issued, close not reported yet
+            bool open{false}; ///< handshake done and subscribed
+            bool closing_for_restart{false}; ///< suppresses the close callback of restartSync()'s cancel
+            std::uint64_t last_seq{0}; ///< highest last_seq this leg delivered since it (re)connected
+            std::int64_t last_msg_ns{0};
+            std::uint64_t wins{0}; ///< book frames applied from this leg since last heartbeat
+            std::uint64_t dups{0}; ///< book frames already delivered by another leg since last heartbeat
+            boost::asio::steady_timer reconnect_timer; ///< single-leg reconnect (others stay up)
+            std::uint64_t reconnect_gen{0};
+            int reconnect_delay_ms{1000};
         };
 
         /**
@@ -115,14 +143,29 @@ namespace md {
             SYNCED
         };
 
-        /// Open the websocket using the already resolved runtime endpoint.
+        /// Open every leg using the already resolved runtime endpoint.
         void connectWS();
 
-        /// Send the subscribe frame and transition into the venue's sync mode.
-        void onWSOpen();
+        /// (Re)connect one leg.
+        void connectLeg_(std::size_t leg);
+
+        /// Send the subscribe frame; the first leg open after a (re)start transitions into the venue's sync mode.
+        void onWSOpen(std::size_t leg);
 
         /// Main raw websocket message entry point.
-        void onWSMessage(const char *data, std::size_t len);
+        void onWSMessage(std::size_t leg, const char *data, std::size_t len);
+
+        /**
+         * First-arrival arbitration across legs (only with more than one leg). Returns false when the
+         * frame must not go further: already delivered by another leg, or ahead of what has been applied
+         * while another open leg can still deliver the missing range (held at most kArbGapHoldMs).
+         * A leg whose own sequence goes backwards means the venue reset the stream: resync.
+         */
+        bool arbitrate_(WsLeg &leg, FrameKind kind, const GenericSnapshotFormat &snap,
+                        const GenericIncrementalFormat &inc, std::int64_t now_ns);
+
+        /// Lowest-index open leg: the only source of seq-less frames when arbitrating.
+        const WsLeg *primary_leg_() const noexcept;
 
         /// Request REST snapshot for rest-anchored venues.
         void requestSnapshot();
@@ -136,6 +179,9 @@ namespace md {
         /// Drain buffered incrementals through the normal apply path.
         void drainBufferedIncrementals();
 
+        /// Move 'inc' into the buffer; on overflow restart sync with 'overflow_reason' and return false.
+        bool bufferIncremental_(GenericIncrementalFormat &inc, std::string_view overflow_reason);
+
         /// Perform venue-specific bootstrap before websocket connect if required.
         void bootstrapWS();
 
@@ -144,17 +190,25 @@ namespace md {
         static const char *sync_state_to_string_(FeedSyncState state) noexcept;
         void set_state_(FeedSyncState next, std::string_view reason);
 
-        /// Handle websocket close callback and decide whether to resync.
-        void onWSClose_();
+        /// Handle websocket close callback: reconnect the leg alone while another leg keeps the feed, else resync.
+        void onWSClose_(std::size_t leg);
 
         /// Schedule the next connect attempt after a controlled delay.
         void schedule_ws_reconnect_(std::chrono::milliseconds delay);
 
+        /// Reconnect one leg after its own backoff; a restartSync() in between supersedes it.
+        void schedule_leg_reconnect_(std::size_t leg);
+
+        /// Cancel legs that stayed silent for ws_stale_after_ms while another leg kept the feed moving.
+        void check_stale_legs_();
+
         /**
          * Refresh the silent-socket watchdog.
          *
          * The watchdog detects the "process still alive but feed stopped moving"
          * failure mode where no close/error event is delivered by the socket.
+         * With several legs it instead ticks every ws_stale_after_ms / 2 while armed and
+         * also runs check_stale_legs_().
          */
         void arm_ws_watchdog_();
 
@@ -163,14 +217,17 @@ namespace md {
 
         void persist_snapshot_(const GenericSnapshotFormat &snap, std::string_view source);
         void persist_incremental_(const GenericIncrementalFormat &inc, std::string_view source);
-        void maybe_persist_book_(std::string_view source);
+        /// Every call counts towards the cadence; 'change' (incrementals only) tells whether the update
+        /// touched the persisted top-N, and a due checkpoint is skipped if none did since the last one
+        void maybe_persist_book_(std::string_view source, const BookChange *change = nullptr);
 
     private:
         boost::asio::io_context &ioc_;
-        std::shared_ptr<WsClient> ws_;
+        std::vector<WsLeg> legs_; ///< venue websocket connections (one unless ws_connections > 1)
         std::shared_ptr<RestClient> rest_;
 
         std::string connect_id_;
+        std::string ws_bootstrap_body_; ///< last bootstrap response, resolved again per leg (own connect id)
 
         std::unique_ptr<OrderBookController> controller_;
         std::unique_ptr<FilePersistSink> persist_;
@@ -178,17 +235,19 @@ namespace md {
 
         FeedHandlerConfig cfg_; /// DO NOT READ IN HOT PATH
         RuntimeResolved rt_;
-        AnyAdapter adapter_;
+        Adapter adapter_;
 
         std::atomic<bool> running_{false};
         FeedSyncState state_{FeedSyncState::DISCONNECTED};
 
-        /// Buffered incrementals captured before a valid baseline is ready.
-        struct BufferedMsg {
-            std::string payload;
-            std::int64_t recv_ts_ns{0};
-        };
-        std::deque<BufferedMsg> buffer_; /// later optimize to ring buffer / pooled storage
+        /// Per-frame scratch messages: adapters reset() and refill them, so the level vectors keep
+        /// their capacity and a steady-state frame parses without touching the allocator.
+        /// A buffered incremental takes the vectors with it (pre-sync only); the next frame regrows them.
+        GenericSnapshotFormat scratch_snap_;
+        GenericIncrementalFormat scratch_inc_;
+
+        /// Incrementals captured (already parsed, receive timestamp set) before a valid baseline is ready.
+        std::deque<GenericIncrementalFormat> buffer_; /// later optimize to ring buffer / pooled storage
         std::size_t max_buffer_{10'000};
 
         boost::asio::steady_timer reconnect_timer_; ///< delayed reconnect/backoff timer
@@ -196,6 +255,7 @@ namespace md {
         boost::asio::steady_timer heartbeat_timer_; ///< periodic stats heartbeat
         std::uint64_t reconnect_gen_{0}; ///< invalidates old reconnect callbacks
         std::uint64_t ws_watchdog_gen_{0}; ///< invalidates old watchdog callbacks
+        bool ws_watchdog_pending_{false}; ///< watchdog wait outstanding (multi-leg: not pushed back per frame)
         bool reconnect_scheduled_{false};
 
         // B6: exponential reconnect backoff state
@@ -206,12 +266,12 @@ namespace md {
         std::chrono::milliseconds next_reconnect_delay_() noexcept;
         /// Resets backoff to initial value (called on successful SYNCED transition).
         void reset_reconnect_delay_() noexcept;
-        bool closing_for_restart_{false}; ///< suppresses duplicate restart on self-initiated close
         bool ws_watchdog_announced_{false};
         std::int64_t last_ws_message_ns_{0}; ///< last raw websocket frame receive time
         std::size_t persist_book_every_updates_{0};
         std::size_t persist_book_top_{0};
         std::size_t updates_since_book_persist_{0};
+        bool book_state_dirty_{true}; ///< persisted top-N changed since the last book_state
 
         // B6 / C4: REST request timing
         std::int64_t rest_request_start_ns_{0}; ///< when requestSnapshot() was last called
@@ -221,8 +281,26 @@ namespace md {
         std::uint64_t ctr_resyncs_{0};         ///< total restartSync() calls
         std::uint64_t ctr_book_updates_{0};    ///< total applied incremental updates
         std::uint64_t ctr_outbox_drops_{0};    ///< WsPublishSink outbox overflow drops (approximation)
+        std::uint64_t ctr_update_allocs_{0};   ///< heap allocations while handling applied updates (POP_COUNT_ALLOCS)
+        std::uint64_t ctr_rx_stamped_{0};      ///< frames with a kernel receive timestamp since last heartbeat
+        std::int64_t ctr_rx_queue_ns_sum_{0};  ///< sum of (userspace - kernel) receive time over those frames
+        std::int64_t ctr_rx_queue_ns_max_{0};
+
+        // Leg arbitration (reset on every restartSync)
+        std::uint64_t arb_last_seq_{0};        ///< highest last_seq let through in the current sync epoch
+        std::int64_t arb_gap_since_ns_{0};     ///< when a leg first ran ahead of arb_last_seq_, 0 = none
+        std::uint64_t ctr_arb_held_{0};        ///< frames dropped while waiting for a slower leg, since last heartbeat
 
         void arm_heartbeat_();
         void emit_heartbeat_();
     };
+
+    extern template class GenericFeedHandler<BinanceAdapter>;
+    extern template class GenericFeedHandler<OKXAdapter>;
+    extern template class GenericFeedHandler<BitgetAdapter>;
+    extern template class GenericFeedHandler<BybitAdapter>;
+    extern template class GenericFeedHandler<KucoinAdapter>;
+
+    /// Cold-path venue selection: the handler instantiation for 'v' (unknown venues fall back to Binance).
+    std::unique_ptr<IVenueFeedHandler> makeFeedHandler(VenueId v, boost::asio::io_context &ioc);
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include <string_view>
 #include <cstddef>
+#include <utility>
 
 #include "abstract/FeedHandler.hpp"
 #include "orderbook/OrderBookController.hpp"
@@ -26,8 +27,28 @@ namespace md {
         // resolved checksum policy (cold path)
         ChecksumFn checksum_fn{nullptr};
         std::uint8_t checksum_top_n{25};
+        bool checksum_opt_in{false}; // checksum_fn is only wired with --require_checksum
+        bool checksum_incremental{false}; // checksum_fn is checkInterleavedCRC32: track it per update
     };
 
+    /// What classifyAndParse() found in a WS frame.
+    enum class FrameKind : std::uint8_t {
+        Ignore, // not a book frame, or malformed
+        Snapshot, // WS snapshot parsed into 'snap'
+        Incremental, // incremental update parsed into 'inc'
+        Pong, // application-level pong
+        SubscribeAck // subscription confirmation
+    };
+
+    /// Book frames are scanned into 'inc' before their kind is known; a snapshot takes the level
+    /// vectors over by swap, so both messages keep their capacity. The arenas go along, so any text
+    /// the levels point into stays with them.
+    inline void takeSnapshotLevels(GenericIncrementalFormat &inc, GenericSnapshotFormat &snap) noexcept {
+        snap.bids.swap(inc.bids);
+        snap.asks.swap(inc.asks);
+        std::swap(snap.text, inc.text);
+    }
+
     struct EndPoint {
         std::string host;
         std::string port;
@@ -59,15 +80,11 @@ namespace md {
 
         /**
          * Hot-path:
-         *      - cheap filter + parse
+         *      - classify + parse in one scan: a book frame lands in 'snap' or 'inc' (both reset
+         *        first when touched), control frames are only classified
          */
-        bool isIncremental(std::string_view msg) const noexcept;
-
-        bool parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const;
-
-        /// WS snapshot hooks (for WsAuthoritative venues)
-        bool isSnapshot(std::string_view msg) const noexcept { return false; }
-        bool parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &) const { return false; }
+        FrameKind classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                   GenericIncrementalFormat &inc) const;
 
         /// REST snapshot
         bool parseSnapshot(std::string_view body, GenericSnapshotFormat &out) const;
@@ -89,13 +106,8 @@ namespace md {
 
         std::string restSnapshotTarget(const FeedHandlerConfig &cfg) const;
 
-        bool isIncremental(std::string_view msg) const noexcept;
-
-        bool parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const;
-
-        bool isSnapshot(std::string_view msg) const noexcept;
-
-        bool parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &out) const;
+        FrameKind classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                   GenericIncrementalFormat &inc) const;
 
         /// OKX does not use REST Snapshots, so can return false
         bool parseSnapshot(std::string_view, GenericSnapshotFormat &) const { return false; }
@@ -118,13 +130,8 @@ namespace md {
 
         std::string restSnapshotTarget(const FeedHandlerConfig &cfg) const;
 
-        bool isIncremental(std::string_view msg) const noexcept;
-
-        bool parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const;
-
-        bool isSnapshot(std::string_view msg) const noexcept;
-
-        bool parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &out) const;
+        FrameKind classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                   GenericIncrementalFormat &inc) const;
 
         bool parseSnapshot(std::string_view, GenericSnapshotFormat &) const { return false; };
 
@@ -145,13 +152,8 @@ namespace md {
 
         std::string restSnapshotTarget(const FeedHandlerConfig &cfg) const;
 
-        bool isIncremental(std::string_view msg) const noexcept;
-
-        bool parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const;
-
-        bool isSnapshot(std::string_view msg) const noexcept;
-
-        bool parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &out) const;
+        FrameKind classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                   GenericIncrementalFormat &inc) const;
 
         bool parseSnapshot(std::string_view, GenericSnapshotFormat &) const { return false; };
 
@@ -172,13 +174,8 @@ namespace md {
 
         std::string restSnapshotTarget(const FeedHandlerConfig &cfg) const;
 
-        bool isIncremental(std::string_view msg) const noexcept;
-
-        bool parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const;
-
-        bool isSnapshot(std::string_view) const noexcept { return false; };
-
-        bool parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &) const { return false; };
+        FrameKind classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                   GenericIncrementalFormat &inc) const;
 
         bool parseSnapshot(std::string_view, GenericSnapshotFormat &) const;
 
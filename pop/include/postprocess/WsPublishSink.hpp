@@ -39,6 +39,9 @@ namespace md {
      *   - Peer verification is enabled by default.
      *   - Pass insecure_tls=true to disable cert/host checking (local testing only).
      *     A warning is emitted to stderr on every connection when this flag is set.
+     *
+     * Compression:
+     *   - permessage-deflate is offered when 'deflate.enabled' and used if brain accepts it.
      */
     class WsPublishSink {
     public:
@@ -50,7 +53,9 @@ namespace md {
                       std::string venue,
                       std::string symbol,
                       std::string client_certfile = {},
-                      std::string client_keyfile = {});
+                      std::string client_keyfile = {},
+                      WsDeflateOptions deflate = {},
+                      const SocketOptions &socket_opts = {});
 
         void start();
         void stop();
@@ -68,6 +73,9 @@ namespace md {
                                 std::string_view source,
                                 std::int64_t ts_book_ns) noexcept;
 
+        /// Traffic of the current brain connection (see WsClient::traffic()).
+        const WsTraffic &traffic() const noexcept { return ws_->traffic(); }
+
     private:
         static std::int64_t now_ns_() noexcept;
         static nlohmann::json levels_to_json_(const std::vector<Level> &levels);
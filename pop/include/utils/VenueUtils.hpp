@@ -83,42 +83,4 @@ namespace md {
             }
         }
     }
-
-    static bool json_to_u64_flexible(const json &jv, std::uint64_t &out) noexcept {
-        try {
-            if (jv.is_number_unsigned()) {
-                out = jv.get<std::uint64_t>();
-                return true;
-            }
-            if (jv.is_number_integer()) {
-                auto v = jv.get<std::int64_t>();
-                if (v < 0) return false;
-                out = (std::uint64_t) v;
-                return true;
-            }
-            if (jv.is_string()) {
-                out = std::stoull(jv.get<std::string>());
-                return true;
-            }
-            return false;
-        } catch (...) { return false; }
-    }
-
-    static bool json_to_i64_flexible(const json &jv, std::int64_t &out) noexcept {
-        try {
-            if (jv.is_number_integer()) {
-                out = jv.get<std::int64_t>();
-                return true;
-            }
-            if (jv.is_number_unsigned()) {
-                out = static_cast<std::int64_t>(jv.get<std::uint64_t>());
-                return true;
-            }
-            if (jv.is_string()) {
-                out = std::stoll(jv.get<std::string>());
-                return true;
-            }
-            return false;
-        } catch (...) { return false; }
-    }
 } // namespace md
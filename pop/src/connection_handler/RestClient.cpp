@@ -283,6 +283,10 @@ namespace md {
                                        [self](const boost::system::error_code &ec, const tcp::endpoint &) {
                                            if (ec) return self->fail_(ec);
 
+                                           const std::string failed = applySocketOptions(
+                                               beast::get_lowest_layer(*self->stream_), self->sock_opts_);
+                                           if (!failed.empty()) self->emit_log_("[RESTCLIENT] socket options: " + failed);
+
                                            // SNI
                                            if (!SSL_set_tlsext_host_name(
                                                self->stream_->native_handle(), self->host_.c_str())) {
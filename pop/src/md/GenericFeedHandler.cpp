@@ -1,4 +1,5 @@
 #include "md/GenericFeedHandler.hpp"
+#include "utils/AllocCounter.hpp"
 #include <chrono>
 #include <random>
 #include <spdlog/spdlog.h>
@@ -9,14 +10,16 @@ namespace md
     {
         constexpr int kDefaultWsPingIntervalMs = 15'000;
         constexpr int kMinWsStaleAfterMs = 30'000;
+        /// How long a leg running ahead of the applied sequence waits for a slower leg to fill the gap.
+        constexpr std::int64_t kArbGapHoldMs = 500;
     }
 
-    GenericFeedHandler::GenericFeedHandler(boost::asio::io_context &ioc) : ioc_(ioc),
-                                                                           ws_(WsClient::create(ioc)),
-                                                                           rest_(RestClient::create(ioc)),
-                                                                           reconnect_timer_(ioc),
-                                                                           ws_watchdog_timer_(ioc),
-                                                                           heartbeat_timer_(ioc)
+    template<typename Adapter>
+    GenericFeedHandler<Adapter>::GenericFeedHandler(boost::asio::io_context &ioc) : ioc_(ioc),
+                                                                                    rest_(RestClient::create(ioc)),
+                                                                                    reconnect_timer_(ioc),
+                                                                                    ws_watchdog_timer_(ioc),
+                                                                                    heartbeat_timer_(ioc)
     {
         rest_->set_keep_alive(true); // strongly recommended for snapshots
         rest_->set_logger([](std::string_view s)
@@ -24,20 +27,23 @@ namespace md
             spdlog::debug("{}", s); });
     }
 
-    std::string GenericFeedHandler::makeConnectId() const
+    template<typename Adapter>
+    std::string GenericFeedHandler<Adapter>::makeConnectId() const
     {
         const auto now = std::chrono::steady_clock::now().time_since_epoch();
         const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
         return std::to_string(ms);
     }
 
-    std::int64_t GenericFeedHandler::now_ns_() noexcept
+    template<typename Adapter>
+    std::int64_t GenericFeedHandler<Adapter>::now_ns_() noexcept
     {
         const auto now = std::chrono::system_clock::now().time_since_epoch();
         return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
     }
 
-    const char *GenericFeedHandler::sync_state_to_string_(FeedSyncState state) noexcept
+    template<typename Adapter>
+    const char *GenericFeedHandler<Adapter>::sync_state_to_string_(FeedSyncState state) noexcept
     {
         switch (state)
         {
@@ -60,7 +66,8 @@ namespace md
         }
     }
 
-    void GenericFeedHandler::set_state_(FeedSyncState next, std::string_view reason)
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::set_state_(FeedSyncState next, std::string_view reason)
     {
         if (state_ == next)
             return;
@@ -89,26 +96,8 @@ namespace md
         }
     }
 
-    GenericFeedHandler::AnyAdapter GenericFeedHandler::makeAdapter(VenueId v)
-    {
-        switch (v)
-        {
-        case VenueId::BINANCE:
-            return BinanceAdapter{};
-        case VenueId::OKX:
-            return OKXAdapter{};
-        case VenueId::BITGET:
-            return BitgetAdapter{};
-        case VenueId::BYBIT:
-            return BybitAdapter{};
-        case VenueId::KUCOIN:
-            return KucoinAdapter{};
-        default:
-            return BinanceAdapter{};
-        }
-    }
-
-    FeedOpResult GenericFeedHandler::init(const FeedHandlerConfig &cfg)
+    template<typename Adapter>
+    FeedOpResult GenericFeedHandler<Adapter>::init(const FeedHandlerConfig &cfg)
     {
         if (running_.load())
             return FeedOpResult::ERROR;
@@ -119,24 +108,19 @@ namespace md
 
         rest_->set_timeout(std::chrono::milliseconds(cfg_.rest_timeout_ms));
         rest_->set_shutdown_timeout(std::chrono::milliseconds(2000));
+        rest_->set_socket_options(cfg_.socket);
 
-        adapter_ = makeAdapter(cfg.venue_name);
-        rt_.caps = std::visit([&](auto const &a)
-                              { return a.caps(); }, adapter_);
+        rt_.caps = adapter_.caps();
 
         rt_.venue = cfg_.venue_name;
         rt_.depth = cfg_.depthLevel;
 
         /// Resolve endpoints + prebuild frames/targets once (Cold Path)
-        rt_.ws = std::visit([&](auto const &a)
-                            { return a.wsEndpoint(cfg_); }, adapter_);
-        rt_.rest = std::visit([&](auto const &a)
-                              { return a.restEndpoint(cfg_); }, adapter_);
-
-        rt_.wsSubscribeFrame = std::visit([&](auto const &a)
-                                          { return a.wsSubscribeFrame(cfg_); }, adapter_);
-        rt_.restSnapshotTarget = std::visit([&](auto const &a)
-                                            { return a.restSnapshotTarget(cfg_); }, adapter_);
+        rt_.ws = adapter_.wsEndpoint(cfg_);
+        rt_.rest = adapter_.restEndpoint(cfg_);
+
+        rt_.wsSubscribeFrame = adapter_.wsSubscribeFrame(cfg_);
+        rt_.restSnapshotTarget = adapter_.restSnapshotTarget(cfg_);
         rt_.ws_ping_interval_ms = kDefaultWsPingIntervalMs;
         rt_.ws_stale_after_ms = kMinWsStaleAfterMs;
 
@@ -147,8 +131,39 @@ namespace md
         if (!cfg_.rest_path.empty())
             rt_.restSnapshotTarget = cfg_.rest_path;
 
-        controller_ = std::make_unique<OrderBookController>(rt_.depth);
+        legs_.clear();
+        legs_.reserve(static_cast<std::size_t>(std::max(1, cfg_.ws_connections)));
+        for (int i = 0; i < std::max(1, cfg_.ws_connections); ++i)
+        {
+            WsLeg &leg = legs_.emplace_back(ioc_);
+            leg.ws = WsClient::create(ioc_);
+            leg.ws->set_logger([](std::string_view s)
+                               {
+                spdlog::debug("{}", s); });
+        }
+        rt_.arbitrate = legs_.size() > 1;
+        if (rt_.arbitrate)
+        {
+            spdlog::info("[GFH] redundant ws connections={} (first-arrival arbitration by last_seq)", legs_.size());
+        }
+
+        // Opt-in checksums (venues whose checksum is not reliable against the WS baseline) are
+        // only validated in strict mode.
+        if (rt_.caps.checksum_opt_in && !cfg_.require_checksum)
+            rt_.caps.checksum_fn = nullptr;
+
+        // The checksum covers the venue's top checksum_top_n levels, read from the published book:
+        // a book publishing fewer can never match, so validation is off for it.
+        if (rt_.caps.checksum_fn && rt_.depth < rt_.caps.checksum_top_n)
+        {
+            spdlog::warn("[GFH] checksum disabled venue={}: depthLevel={} is below the checksummed top-{}",
+                         to_string(rt_.venue), rt_.depth, rt_.caps.checksum_top_n);
+            rt_.caps.checksum_fn = nullptr;
+        }
+
+        controller_ = std::make_unique<OrderBookController>(rt_.depth, cfg_.book);
         controller_->configureChecksum(rt_.caps.checksum_fn, rt_.caps.checksum_top_n);
+        controller_->setIncrementalChecksum(rt_.caps.checksum_fn && rt_.caps.checksum_incremental);
         controller_->setHasChecksum(rt_.caps.has_checksum);
         if (cfg_.require_checksum) {
             controller_->setRequireChecksum(true);
@@ -173,6 +188,7 @@ namespace md
         persist_book_every_updates_ = cfg_.persist_book_every_updates;
         persist_book_top_ = cfg_.persist_book_top > 0 ? cfg_.persist_book_top : rt_.depth;
         updates_since_book_persist_ = 0;
+        book_state_dirty_ = true;
         if (!cfg_.persist_path.empty())
         {
             persist_ = std::make_unique<FilePersistSink>(cfg_.persist_path, to_string(rt_.venue), cfg_.symbol);
@@ -202,12 +218,19 @@ namespace md
                                                             to_string(rt_.venue),
                                                             cfg_.symbol,
                                                             cfg_.brain_ws_certfile,
-                                                            cfg_.brain_ws_keyfile);
+                                                            cfg_.brain_ws_keyfile,
+                                                            cfg_.brain_ws_deflate,
+                                                            cfg_.socket);
             spdlog::info("[GFH] brain publish enabled: {}:{}{}", host, port, path);
         }
 
+        // Level text is only needed by the checksum and by sinks that serialize book levels.
+        controller_->setRetainLevelText(rt_.caps.checksum_fn != nullptr || persist_ || brain_publish_);
+
         buffer_.clear();
         set_state_(FeedSyncState::DISCONNECTED, "init");
+        arb_last_seq_ = 0;
+        arb_gap_since_ns_ = 0;
         last_ws_message_ns_ = 0;
         ws_watchdog_gen_ = 0;
         ws_watchdog_announced_ = false;
@@ -224,7 +247,8 @@ namespace md
         return FeedOpResult::OK;
     }
 
-    FeedOpResult GenericFeedHandler::start()
+    template<typename Adapter>
+    FeedOpResult GenericFeedHandler<Adapter>::start()
     {
         if (running_.exchange(true))
         {
@@ -233,15 +257,18 @@ namespace md
 
         set_state_(FeedSyncState::CONNECTING, "start");
 
-        /// Wire WS callback once
-        ws_->set_on_open([this]
-                         { onWSOpen(); });
-        ws_->set_on_raw_message([this](const char *data, std::size_t len)
-                                { onWSMessage(data, len); });
-        ws_->set_on_close([this]
-                          {
-            if (!running_.load(std::memory_order_acquire)) return;
-            onWSClose_(); });
+        /// Wire WS callbacks once per leg
+        for (std::size_t i = 0; i < legs_.size(); ++i)
+        {
+            legs_[i].ws->set_on_open([this, i]
+                                     { onWSOpen(i); });
+            legs_[i].ws->set_on_raw_message([this, i](const char *data, std::size_t len)
+                                            { onWSMessage(i, data, len); });
+            legs_[i].ws->set_on_close([this, i]
+                                      {
+                if (!running_.load(std::memory_order_acquire)) return;
+                onWSClose_(i); });
+        }
 
         connect_id_ = makeConnectId();
 
@@ -259,14 +286,21 @@ namespace md
         return FeedOpResult::OK;
     }
 
-    FeedOpResult GenericFeedHandler::stop()
+    template<typename Adapter>
+    FeedOpResult GenericFeedHandler<Adapter>::stop()
     {
         running_.store(false, std::memory_order_release);
 
         if (rest_)
             rest_->cancel();
-        if (ws_)
-            ws_->close();
+        for (WsLeg &leg : legs_)
+        {
+            ++leg.reconnect_gen;
+            leg.reconnect_timer.cancel();
+            leg.ws->close();
+            leg.active = false;
+            leg.open = false;
+        }
         if (brain_publish_)
             brain_publish_->stop();
         disarm_ws_watchdog_();
@@ -282,6 +316,7 @@ namespace md
         persist_book_every_updates_ = 0;
         persist_book_top_ = 0;
         updates_since_book_persist_ = 0;
+        book_state_dirty_ = true;
         last_ws_message_ns_ = 0;
         ws_watchdog_announced_ = false;
         return FeedOpResult::OK;
@@ -289,42 +324,86 @@ namespace md
 
     /**
      * - Generic WS connect uses resolved endpoint
+     * - With a bootstrap, legs after the first resolve it again with their own connect id
+     * - Legs after the first take their host from ws_alt_hosts when one is given
      */
-    void GenericFeedHandler::connectWS()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::connectWS()
+    {
+        for (std::size_t i = 0; i < legs_.size(); ++i)
+        {
+            WsLeg &leg = legs_[i];
+            leg.ep = rt_.ws;
+            if (i > 0 && rt_.caps.requires_ws_bootstrap && !ws_bootstrap_body_.empty())
+            {
+                WsBootstrapInfo info;
+                const std::string leg_connect_id = connect_id_ + "-" + std::to_string(i);
+                if (adapter_.parseWsBootstrap(ws_bootstrap_body_, leg_connect_id, info))
+                    leg.ep = info.ws;
+            }
+            if (i > 0 && i - 1 < cfg_.ws_alt_hosts.size() && !cfg_.ws_alt_hosts[i - 1].empty())
+                leg.ep.host = cfg_.ws_alt_hosts[i - 1];
+            connectLeg_(i);
+        }
+    }
+
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::connectLeg_(std::size_t i)
     {
+        WsLeg &leg = legs_[i];
         if (rt_.ws_ping_interval_ms > 0)
         {
-            ws_->set_idle_ping(std::chrono::milliseconds(rt_.ws_ping_interval_ms));
+            leg.ws->set_idle_ping(std::chrono::milliseconds(rt_.ws_ping_interval_ms));
         }
         else
         {
-            ws_->set_idle_ping(std::chrono::milliseconds(0));
+            leg.ws->set_idle_ping(std::chrono::milliseconds(0));
         }
-        spdlog::info("[GFH] connecting websocket venue={} host={} port={} target={} ping_interval_ms={} stale_after_ms={}",
-                     to_string(rt_.venue), rt_.ws.host, rt_.ws.port, rt_.ws.target,
+        leg.ws->set_deflate(cfg_.ws_deflate);
+        leg.ws->set_socket_options(cfg_.socket);
+        leg.ws->set_kernel_rx_timestamps(cfg_.kernel_rx_timestamps);
+        spdlog::info("[GFH] connecting websocket venue={} leg={} host={} port={} target={} ping_interval_ms={} stale_after_ms={}",
+                     to_string(rt_.venue), i, leg.ep.host, leg.ep.port, leg.ep.target,
                      rt_.ws_ping_interval_ms, rt_.ws_stale_after_ms);
-        ws_->connect(rt_.ws.host, rt_.ws.port, rt_.ws.target);
+        leg.active = true;
+        leg.open = false;
+        leg.closing_for_restart = false;
+        leg.last_seq = 0;
+        leg.ws->connect(leg.ep.host, leg.ep.port, leg.ep.target);
     }
 
     /**
      * Subscribe to stream
      */
-    void GenericFeedHandler::onWSOpen()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::onWSOpen(std::size_t i)
     {
         if (!running_.load())
             return;
 
-        last_ws_message_ns_ = now_ns_();
+        WsLeg &leg = legs_[i];
+        leg.open = true;
+        leg.reconnect_delay_ms = kReconnectInitMs;
+        leg.last_msg_ns = now_ns_();
+        last_ws_message_ns_ = leg.last_msg_ns;
         arm_ws_watchdog_();
 
-        spdlog::info("[GFH] websocket connected venue={} host={} port={} target={}",
-                     to_string(rt_.venue), rt_.ws.host, rt_.ws.port, rt_.ws.target);
+        spdlog::info("[GFH] websocket connected venue={} leg={} host={} port={} target={}",
+                     to_string(rt_.venue), i, leg.ep.host, leg.ep.port, leg.ep.target);
 
         if (!rt_.wsSubscribeFrame.empty())
         {
-            spdlog::info("[GFH] sending ws subscribe venue={} payload_bytes={}",
-                         to_string(rt_.venue), rt_.wsSubscribeFrame.size());
-            ws_->send_text(rt_.wsSubscribeFrame);
+            spdlog::info("[GFH] sending ws subscribe venue={} leg={} payload_bytes={}",
+                         to_string(rt_.venue), i, rt_.wsSubscribeFrame.size());
+            leg.ws->send_text(rt_.wsSubscribeFrame);
+        }
+
+        // A leg rejoining a running sync only adds its copy of the stream.
+        if (state_ != FeedSyncState::CONNECTING && state_ != FeedSyncState::BOOTSTRAPPING)
+        {
+            spdlog::info("[GFH] ws leg joined running sync venue={} leg={} state={}",
+                         to_string(rt_.venue), i, sync_state_to_string_(state_));
+            return;
         }
 
         if (rt_.caps.sync_mode == SyncMode::RestAnchored)
@@ -343,7 +422,8 @@ namespace md
     /**
      * - Async GET snapshot
      */
-    void GenericFeedHandler::requestSnapshot()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::requestSnapshot()
     {
         set_state_(FeedSyncState::WAIT_REST_SNAPSHOT, "request_snapshot");
         spdlog::info("[GFH] requesting REST snapshot venue={} host={} port={} target={}",
@@ -392,7 +472,8 @@ namespace md
                          });
     }
 
-    void GenericFeedHandler::onSnapshotResponse(std::string_view body)
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::onSnapshotResponse(std::string_view body)
     {
         if (!running_.load())
             return;
@@ -413,8 +494,7 @@ namespace md
         }
 
         GenericSnapshotFormat snap;
-        const bool ok = std::visit([&](auto const &a)
-                                   { return a.parseSnapshot(body, snap); }, adapter_);
+        const bool ok = adapter_.parseSnapshot(body, snap);
 
         if (!ok)
         {
@@ -455,71 +535,100 @@ namespace md
         }
     }
 
-    void GenericFeedHandler::drainBufferedIncrementals()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::drainBufferedIncrementals()
     {
         while (!buffer_.empty())
         {
-            GenericIncrementalFormat inc;
-
-            const BufferedMsg buffered = std::move(buffer_.front());
-
-            const bool ok = std::visit([&](auto const &a)
-                                       {
-                if (!a.isIncremental(buffered.payload)) return false;
-                return a.parseIncremental(buffered.payload, inc); }, adapter_);
-
+            const GenericIncrementalFormat inc = std::move(buffer_.front());
             buffer_.pop_front();
 
-            if (!ok)
-                continue;
-            inc.ts_recv_ns = buffered.recv_ts_ns;
-
-            const auto action = controller_->onIncrement(inc);
+            BookChange change;
+            const auto action = controller_->onIncrement(inc, &change);
             persist_incremental_(inc, "ws_incremental");
             if (action == OrderBookController::Action::NeedResync)
             {
                 restartSync("buffered_incremental_need_resync");
                 return;
             }
-            maybe_persist_book_("incremental_applied");
+            maybe_persist_book_("incremental_applied", &change);
         }
     }
 
-    void GenericFeedHandler::onWSMessage(const char *data, std::size_t len)
+    template<typename Adapter>
+    bool GenericFeedHandler<Adapter>::bufferIncremental_(GenericIncrementalFormat &inc, std::string_view overflow_reason)
+    {
+        if (buffer_.size() >= max_buffer_)
+        {
+            restartSync(overflow_reason);
+            return false;
+        }
+        inc.ownText(); // the frame's receive buffer is reused once this callback returns
+        buffer_.push_back(std::move(inc));
+        return true;
+    }
+
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::onWSMessage(std::size_t leg_idx, const char *data, std::size_t len)
     {
         if (!running_.load() || len == 0)
             return;
         ++ctr_msgs_received_;
+        WsLeg &leg = legs_[leg_idx];
         std::string_view msg{data, len};
         const std::int64_t recv_ts_ns = now_ns_();
+        const std::int64_t kernel_ts_ns = leg.ws->last_rx_kernel_ns();
         last_ws_message_ns_ = recv_ts_ns;
+        leg.last_msg_ns = recv_ts_ns;
+        if (kernel_ts_ns > 0)
+        {
+            // Kernel -> handler: socket queueing, TLS decrypt, WS deframing / inflate.
+            const std::int64_t queued_ns = recv_ts_ns - kernel_ts_ns;
+            ++ctr_rx_stamped_;
+            ctr_rx_queue_ns_sum_ += queued_ns;
+            ctr_rx_queue_ns_max_ = std::max(ctr_rx_queue_ns_max_, queued_ns);
+        }
         arm_ws_watchdog_();
+        const std::uint64_t allocs_at_entry = alloc::threadCount();
+
+        // One scan per frame: the adapter classifies it and parses a book frame in the same pass,
+        // into the reused scratch messages.
+        GenericSnapshotFormat &snap = scratch_snap_;
+        GenericIncrementalFormat &inc = scratch_inc_;
+        const FrameKind kind = adapter_.classifyAndParse(msg, snap, inc);
+        switch (kind)
+        {
+        case FrameKind::Snapshot:
+            snap.ts_recv_ns = recv_ts_ns;
+            snap.ts_recv_kernel_ns = kernel_ts_ns;
+            break;
+        case FrameKind::Incremental:
+            inc.ts_recv_ns = recv_ts_ns;
+            inc.ts_recv_kernel_ns = kernel_ts_ns;
+            break;
+        case FrameKind::SubscribeAck:
+            spdlog::info("[GFH] subscription acknowledged venue={}", to_string(rt_.venue));
+            return;
+        case FrameKind::Pong: // liveness is already recorded above
+        case FrameKind::Ignore:
+            return;
+        }
+
+        if (rt_.arbitrate && !arbitrate_(leg, kind, snap, inc, recv_ts_ns))
+            return;
 
         if (state_ == FeedSyncState::WAIT_REST_SNAPSHOT)
         {
             // buffer incrementals
-            const bool isInc = std::visit([&](auto const &a)
-                                          { return a.isIncremental(msg); }, adapter_);
-            if (isInc)
-            {
-                if (buffer_.size() < max_buffer_)
-                    buffer_.push_back(BufferedMsg{std::string(msg), recv_ts_ns});
-                else
-                    restartSync("buffer_overflow_wait_rest_snapshot");
-            }
+            if (kind == FrameKind::Incremental)
+                bufferIncremental_(inc, "buffer_overflow_wait_rest_snapshot");
             return;
         }
 
         if (state_ == FeedSyncState::WAIT_WS_SNAPSHOT)
         {
-            // first, try snapshot
-            GenericSnapshotFormat snap;
-            const bool isSnap = std::visit([&](auto const &a)
-                                           { return a.isSnapshot(msg) && a.parseWsSnapshot(msg, snap); }, adapter_);
-
-            if (isSnap)
+            if (kind == FrameKind::Snapshot)
             {
-                snap.ts_recv_ns = recv_ts_ns;
                 persist_snapshot_(snap, "ws_snapshot");
                 const auto snap_action = controller_->onSnapshot(
                     snap, OrderBookController::BaselineKind::WsAuthoritative);
@@ -539,114 +648,178 @@ namespace md
             }
 
             // otherwise buffer incrementals
-            const bool isInc = std::visit([&](auto const &a)
-                                          { return a.isIncremental(msg); }, adapter_);
-            if (isInc)
-            {
-                if (buffer_.size() < max_buffer_)
-                    buffer_.push_back(BufferedMsg{std::string(msg), recv_ts_ns});
-                else
-                    restartSync("buffer_overflow_wait_ws_snapshot");
-            }
+            bufferIncremental_(inc, "buffer_overflow_wait_ws_snapshot");
             return;
         }
 
+        if (state_ != FeedSyncState::WAIT_BRIDGE && state_ != FeedSyncState::SYNCED)
+            return; // Any other state: ignore
+
         // WAIT_BRIDGE and SYNCED:
         // 1) For WS-authoritative venues, allow an "interrupting" WS snapshot at ANY time and re-baseline.
-        if ((state_ == FeedSyncState::WAIT_BRIDGE || state_ == FeedSyncState::SYNCED) && rt_.caps.ws_sends_snapshot)
+        if (kind == FrameKind::Snapshot)
         {
-            GenericSnapshotFormat snap;
-            const bool isSnap = std::visit([&](auto const &a)
-                                           { return a.isSnapshot(msg) && a.parseWsSnapshot(msg, snap); }, adapter_);
+            if (!rt_.caps.ws_sends_snapshot)
+                return;
 
-            if (isSnap)
+            // Hard re-baseline (venue may resend snapshot on internal resync)
+            persist_snapshot_(snap, "ws_snapshot");
+            const auto snap_action = controller_->onSnapshot(
+                snap, OrderBookController::BaselineKind::WsAuthoritative);
+            if (snap_action == OrderBookController::Action::NeedResync)
             {
-                // Hard re-baseline (venue may resend snapshot on internal resync)
-                snap.ts_recv_ns = recv_ts_ns;
-                persist_snapshot_(snap, "ws_snapshot");
-                const auto snap_action = controller_->onSnapshot(
-                    snap, OrderBookController::BaselineKind::WsAuthoritative);
-                if (snap_action == OrderBookController::Action::NeedResync)
-                {
-                    restartSync("interrupting_ws_snapshot_rejected");
-                    return;
-                }
-                maybe_persist_book_("snapshot_applied");
+                restartSync("interrupting_ws_snapshot_rejected");
+                return;
+            }
+            maybe_persist_book_("snapshot_applied");
+
+            // Any buffered incrementals are stale relative to this new baseline.
+            buffer_.clear();
 
-                // Any buffered incrementals are stale relative to this new baseline.
-                buffer_.clear();
+            // WS-authoritative snapshot implies we can treat it as baseline-loaded immediately.
+            // Controller may set Synced directly; keep handler consistent.
+            set_state_(controller_->isSynced() ? FeedSyncState::SYNCED : FeedSyncState::WAIT_BRIDGE,
+                       "interrupting_ws_snapshot");
+            return;
+        }
 
-                // WS-authoritative snapshot implies we can treat it as baseline-loaded immediately.
-                // Controller may set Synced directly; keep handler consistent.
-                set_state_(controller_->isSynced() ? FeedSyncState::SYNCED : FeedSyncState::WAIT_BRIDGE,
-                           "interrupting_ws_snapshot");
+        // 2) Otherwise: apply incrementals
+        // --- RestAnchored: during WAIT_BRIDGE we ONLY buffer+drain ---
+        if (rt_.caps.sync_mode == SyncMode::RestAnchored && state_ == FeedSyncState::WAIT_BRIDGE)
+        {
+            if (!bufferIncremental_(inc, "buffer_overflow_wait_bridge"))
                 return;
+
+            // Try to bridge using the same pipeline as post-snapshot drain
+            drainBufferedIncrementals();
+            if (controller_->isSynced())
+            {
+                spdlog::info("[GFH] bridged (ws buffered path) -> SYNCED");
+                set_state_(FeedSyncState::SYNCED, "ws_buffered_bridge_complete");
             }
+            return;
         }
 
-        // 2) Otherwise: parse + apply incrementals
-        if (state_ == FeedSyncState::WAIT_BRIDGE || state_ == FeedSyncState::SYNCED)
+        // --- Otherwise: steady-state apply (SYNCED, or WS-authoritative venues) ---
+        BookChange change;
+        const auto action = controller_->onIncrement(inc, &change);
+        persist_incremental_(inc, "ws_incremental");
+        if (action == OrderBookController::Action::NeedResync)
         {
-            // --- RestAnchored: during WAIT_BRIDGE we ONLY buffer+drain ---
-            if (rt_.caps.sync_mode == SyncMode::RestAnchored && state_ == FeedSyncState::WAIT_BRIDGE)
-            {
-                const bool isInc = std::visit([&](auto const &a)
-                                              { return a.isIncremental(msg); }, adapter_);
-                if (!isInc)
-                    return;
+            restartSync("steady_state_incremental_need_resync");
+            return;
+        }
+        ++ctr_book_updates_;
+        maybe_persist_book_("incremental_applied", &change);
+        ctr_update_allocs_ += alloc::threadCount() - allocs_at_entry;
 
-                if (buffer_.size() < max_buffer_)
-                    buffer_.push_back(BufferedMsg{std::string(msg), recv_ts_ns});
-                else
-                {
-                    restartSync("buffer_overflow_wait_bridge");
-                    return;
-                }
+        if (state_ == FeedSyncState::WAIT_BRIDGE && controller_->isSynced())
+        {
+            spdlog::info("[GFH] bridged (ws path) -> SYNCED");
+            set_state_(FeedSyncState::SYNCED, "steady_state_bridge_complete");
+        }
+    }
 
-                // Try to bridge using the same pipeline as post-snapshot drain
-                drainBufferedIncrementals();
-                if (controller_->isSynced())
-                {
-                    spdlog::info("[GFH] bridged (ws buffered path) -> SYNCED");
-                    set_state_(FeedSyncState::SYNCED, "ws_buffered_bridge_complete");
-                }
-                return;
-            }
+    template<typename Adapter>
+    bool GenericFeedHandler<Adapter>::arbitrate_(WsLeg &leg, FrameKind kind, const GenericSnapshotFormat &snap,
+                                                 const GenericIncrementalFormat &inc, std::int64_t now_ns)
+    {
+        // Frames racing a restart belong to the previous epoch.
+        if (state_ == FeedSyncState::DISCONNECTED || state_ == FeedSyncState::CONNECTING ||
+            state_ == FeedSyncState::BOOTSTRAPPING)
+            return false;
+
+        // Without a sequence the copies cannot be told apart or ordered: take the frame from the
+        // primary leg only, so the book sees exactly one leg's stream in its own order.
+        const auto from_primary = [&]
+        {
+            if (&leg == primary_leg_())
+                return true;
+            ++leg.dups;
+            return false;
+        };
 
-            // --- Otherwise: steady-state apply (SYNCED, or WS-authoritative venues) ---
-            GenericIncrementalFormat inc;
-            const bool ok = std::visit([&](auto const &a)
-                                       {
-                if (!a.isIncremental(msg)) return false;
-                return a.parseIncremental(msg, inc); }, adapter_);
+        if (kind == FrameKind::Snapshot)
+        {
+            const std::uint64_t seq = snap.lastUpdateId;
+            if (seq == 0)
+                return from_primary();
+            if (seq < leg.last_seq)
+            {
+                restartSync("ws_snapshot_seq_reset");
+                return false;
+            }
+            leg.last_seq = seq;
+            // The first baseline always goes through. Afterwards a leg's subscribe snapshot that is not
+            // ahead of the book would roll it back: drop it.
+            if (state_ != FeedSyncState::WAIT_WS_SNAPSHOT && seq <= arb_last_seq_)
+            {
+                ++leg.dups;
+                return false;
+            }
+            arb_last_seq_ = std::max(arb_last_seq_, seq);
+            arb_gap_since_ns_ = 0;
+            ++leg.wins;
+            return true;
+        }
 
-            if (!ok)
-                return;
-            inc.ts_recv_ns = recv_ts_ns;
+        const std::uint64_t seq = inc.last_seq;
+        if (seq == 0)
+            return from_primary();
+        if (seq < leg.last_seq)
+        {
+            restartSync("ws_leg_seq_regressed");
+            return false;
+        }
+        leg.last_seq = seq;
+        if (seq <= arb_last_seq_)
+        {
+            ++leg.dups;
+            return false;
+        }
 
-            const auto action = controller_->onIncrement(inc);
-            persist_incremental_(inc, "ws_incremental");
-            if (action == OrderBookController::Action::NeedResync)
+        if (arb_last_seq_ != 0 && !rt_.caps.allow_seq_gap && inc.first_seq > arb_last_seq_ + 1)
+        {
+            // This leg joined (or is running) ahead of what has been applied. Another open leg that is
+            // not past the applied sequence will still deliver the missing range; wait for it, bounded.
+            bool can_fill = false;
+            for (const WsLeg &other : legs_)
             {
-                restartSync("steady_state_incremental_need_resync");
-                return;
+                if (&other != &leg && other.open && other.last_seq <= arb_last_seq_)
+                {
+                    can_fill = true;
+                    break;
+                }
             }
-            ++ctr_book_updates_;
-            maybe_persist_book_("incremental_applied");
-
-            if (state_ == FeedSyncState::WAIT_BRIDGE && controller_->isSynced())
+            if (arb_gap_since_ns_ == 0)
+                arb_gap_since_ns_ = now_ns;
+            if (can_fill && now_ns - arb_gap_since_ns_ < kArbGapHoldMs * 1'000'000LL)
             {
-                spdlog::info("[GFH] bridged (ws path) -> SYNCED");
-                set_state_(FeedSyncState::SYNCED, "steady_state_bridge_complete");
+                ++ctr_arb_held_;
+                return false;
             }
-            return;
+            // Nobody can fill it: let the controller see the gap.
         }
 
-        // Any other state: ignore
-        return;
+        arb_last_seq_ = seq;
+        arb_gap_since_ns_ = 0;
+        ++leg.wins;
+        return true;
+    }
+
+    template<typename Adapter>
+    const typename GenericFeedHandler<Adapter>::WsLeg *GenericFeedHandler<Adapter>::primary_leg_() const noexcept
+    {
+        for (const WsLeg &leg : legs_)
+        {
+            if (leg.open)
+                return &leg;
+        }
+        return nullptr;
     }
 
-    void GenericFeedHandler::restartSync(std::string_view reason)
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::restartSync(std::string_view reason)
     {
         if (!running_.load())
             return;
@@ -663,6 +836,8 @@ namespace md
         disarm_ws_watchdog_();
         buffer_.clear();
         controller_->resetBook();
+        arb_last_seq_ = 0;
+        arb_gap_since_ns_ = 0;
 
         // Reset state before reconnect
         set_state_(FeedSyncState::CONNECTING, "restart_sync");
@@ -670,20 +845,29 @@ namespace md
         // Correlate bootstrap if needed
         connect_id_ = makeConnectId();
 
-        // Force-close current WS (immediate) and reconnect after exponential backoff.
-        closing_for_restart_ = true;
-        ws_->cancel();
+        // Force-close every leg (immediate) and reconnect after exponential backoff.
+        for (WsLeg &leg : legs_)
+        {
+            ++leg.reconnect_gen;
+            leg.reconnect_timer.cancel();
+            leg.open = false;
+            if (leg.active)
+            {
+                leg.closing_for_restart = true;
+                leg.ws->cancel();
+            }
+        }
 
         schedule_ws_reconnect_(next_reconnect_delay_());
     }
 
-    void GenericFeedHandler::bootstrapWS()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::bootstrapWS()
     {
         if (!running_.load())
             return;
 
-        const std::string target = std::visit([&](auto const &a)
-                                              { return a.wsBootstrapTarget(cfg_); }, adapter_);
+        const std::string target = adapter_.wsBootstrapTarget(cfg_);
 
         if (target.empty())
         {
@@ -693,8 +877,7 @@ namespace md
             return;
         }
 
-        const std::string body = std::visit([&](auto const &a)
-                                            { return a.wsBootstrapBody(cfg_); }, adapter_);
+        const std::string body = adapter_.wsBootstrapBody(cfg_);
 
         spdlog::info("[GFH] requesting ws bootstrap venue={} host={} port={} target={} body_bytes={}",
                      to_string(rt_.venue), rt_.rest.host, rt_.rest.port, target, body.size());
@@ -710,8 +893,7 @@ namespace md
                               }
 
                               WsBootstrapInfo info;
-                              const bool ok = std::visit([&](auto const &a)
-                                                         { return a.parseWsBootstrap(resp_body, connect_id_, info); }, adapter_);
+                              const bool ok = adapter_.parseWsBootstrap(resp_body, connect_id_, info);
 
                               if (!ok)
                               {
@@ -725,6 +907,7 @@ namespace md
 
                               // overwrite resolved WS endpoint from bootstrap
                               rt_.ws = info.ws;
+                              ws_bootstrap_body_ = resp_body;
                               rt_.ws_ping_interval_ms = info.ping_interval_ms;
                               rt_.ws_ping_timeout_ms = info.ping_timeout_ms;
 
@@ -733,22 +916,41 @@ namespace md
                           });
     }
 
-    void GenericFeedHandler::onWSClose_()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::onWSClose_(std::size_t i)
     {
-        disarm_ws_watchdog_();
+        WsLeg &leg = legs_[i];
+        leg.active = false;
+        leg.open = false;
 
         // If we initiated the close as part of restartSync(), do NOT re-enter restartSync().
-        if (closing_for_restart_)
+        if (leg.closing_for_restart)
         {
-            closing_for_restart_ = false;
+            leg.closing_for_restart = false;
+            disarm_ws_watchdog_();
             return;
         }
 
+        // Another leg keeps the stream (or, before the first open, may still bring it up): reconnect this one alone.
+        const bool starting = state_ == FeedSyncState::CONNECTING || state_ == FeedSyncState::BOOTSTRAPPING;
+        for (const WsLeg &other : legs_)
+        {
+            if (&other != &leg && (other.open || (starting && other.active)))
+            {
+                spdlog::warn("[GFH] ws leg closed, stream continues on the other legs venue={} leg={} host={}",
+                             to_string(rt_.venue), i, leg.ep.host);
+                schedule_leg_reconnect_(i);
+                return;
+            }
+        }
+
         // Unexpected close (network flap, remote close, etc.)
+        disarm_ws_watchdog_();
         restartSync("unexpected_ws_close");
     }
 
-    void GenericFeedHandler::schedule_ws_reconnect_(std::chrono::milliseconds delay)
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::schedule_ws_reconnect_(std::chrono::milliseconds delay)
     {
         ++reconnect_gen_;
         const auto my_gen = reconnect_gen_;
@@ -777,10 +979,58 @@ namespace md
             } });
     }
 
-    void GenericFeedHandler::arm_ws_watchdog_()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::schedule_leg_reconnect_(std::size_t i)
+    {
+        WsLeg &leg = legs_[i];
+        ++leg.reconnect_gen;
+        const auto my_gen = leg.reconnect_gen;
+        const int delay_ms = leg.reconnect_delay_ms;
+        leg.reconnect_delay_ms = std::min(leg.reconnect_delay_ms * 2, kReconnectMaxMs);
+
+        spdlog::info("[GFH] scheduling leg reconnect venue={} leg={} delay_ms={}", to_string(rt_.venue), i, delay_ms);
+
+        leg.reconnect_timer.expires_after(std::chrono::milliseconds(delay_ms));
+        leg.reconnect_timer.async_wait([this, i, my_gen](const boost::system::error_code &ec)
+                                       {
+            if (ec) return;
+            if (!running_.load()) return;
+            if (my_gen != legs_[i].reconnect_gen) return;
+            connectLeg_(i); });
+    }
+
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::check_stale_legs_()
+    {
+        if (!rt_.arbitrate || rt_.ws_stale_after_ms <= 0)
+            return;
+        const std::int64_t now = now_ns_();
+        const std::int64_t stale_ns = static_cast<std::int64_t>(rt_.ws_stale_after_ms) * 1'000'000LL;
+        for (std::size_t i = 0; i < legs_.size(); ++i)
+        {
+            WsLeg &leg = legs_[i];
+            if (!leg.open || now - leg.last_msg_ns < stale_ns)
+                continue;
+            // The feed-level watchdog only fires when every leg is silent; a single stalled leg is
+            // closed here and reconnected on its own by onWSClose_().
+            if (now - last_ws_message_ns_ < stale_ns)
+            {
+                spdlog::warn("[GFH] stale ws leg, reconnecting it venue={} leg={} silence_ms={}",
+                             to_string(rt_.venue), i, (now - leg.last_msg_ns) / 1'000'000LL);
+                leg.ws->cancel();
+            }
+        }
+    }
+
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::arm_ws_watchdog_()
     {
         if (rt_.ws_stale_after_ms <= 0)
             return;
+        // With several legs the watchdog ticks on its own (it also polices single legs) instead of
+        // being pushed back by every frame, which would hide a stalled leg behind the live ones.
+        if (rt_.arbitrate && ws_watchdog_pending_)
+            return;
 
         ++ws_watchdog_gen_;
         const auto my_gen = ws_watchdog_gen_;
@@ -789,12 +1039,15 @@ namespace md
                          to_string(rt_.venue), rt_.ws_stale_after_ms);
             ws_watchdog_announced_ = true;
         }
-        ws_watchdog_timer_.expires_after(std::chrono::milliseconds(rt_.ws_stale_after_ms));
+        const int period_ms = rt_.arbitrate ? std::max(rt_.ws_stale_after_ms / 2, 1) : rt_.ws_stale_after_ms;
+        ws_watchdog_pending_ = true;
+        ws_watchdog_timer_.expires_after(std::chrono::milliseconds(period_ms));
         ws_watchdog_timer_.async_wait([this, my_gen](const boost::system::error_code &ec)
                                       {
             if (ec) return;
             if (!running_.load()) return;
             if (my_gen != ws_watchdog_gen_) return;
+            ws_watchdog_pending_ = false;
             if (state_ == FeedSyncState::DISCONNECTED || state_ == FeedSyncState::CONNECTING || state_ == FeedSyncState::BOOTSTRAPPING) {
                 return;
             }
@@ -805,19 +1058,27 @@ namespace md
                 spdlog::warn("[GFH] stale WS feed detected, restarting sync venue={} silence_ms={}",
                              to_string(rt_.venue), age_ns / 1'000'000LL);
                 restartSync("stale_ws_feed");
+                return;
+            }
+            if (rt_.arbitrate) {
+                check_stale_legs_();
+                arm_ws_watchdog_();
             } });
     }
 
-    void GenericFeedHandler::disarm_ws_watchdog_()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::disarm_ws_watchdog_()
     {
         ++ws_watchdog_gen_;
         ws_watchdog_announced_ = false;
+        ws_watchdog_pending_ = false;
         ws_watchdog_timer_.cancel();
     }
 
     // B6: exponential backoff helpers
 
-    std::chrono::milliseconds GenericFeedHandler::next_reconnect_delay_() noexcept {
+    template<typename Adapter>
+    std::chrono::milliseconds GenericFeedHandler<Adapter>::next_reconnect_delay_() noexcept {
         // Apply ±25 % jitter using a thread_local PRNG (no locks needed on single-threaded Asio)
         static thread_local std::mt19937 rng{std::random_device{}()};
         static thread_local std::uniform_real_distribution<double> jitter(-0.25, 0.25);
@@ -831,23 +1092,27 @@ namespace md
         return std::chrono::milliseconds(std::max(100, jittered)); // floor at 100 ms
     }
 
-    void GenericFeedHandler::reset_reconnect_delay_() noexcept {
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::reset_reconnect_delay_() noexcept {
         reconnect_delay_ms_ = kReconnectInitMs;
     }
 
-    void GenericFeedHandler::persist_snapshot_(const GenericSnapshotFormat &snap, std::string_view source)
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::persist_snapshot_(const GenericSnapshotFormat &snap, std::string_view source)
     {
         if (persist_) persist_->write_snapshot(snap, source);
         if (brain_publish_) brain_publish_->publish_snapshot(snap, source);
     }
 
-    void GenericFeedHandler::persist_incremental_(const GenericIncrementalFormat &inc, std::string_view source)
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::persist_incremental_(const GenericIncrementalFormat &inc, std::string_view source)
     {
         if (persist_) persist_->write_incremental(inc, source);
         if (brain_publish_) brain_publish_->publish_incremental(inc, source);
     }
 
-    void GenericFeedHandler::maybe_persist_book_(std::string_view source)
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::maybe_persist_book_(std::string_view source, const BookChange *change)
     {
         if ((!persist_ && !brain_publish_) || !controller_)
             return;
@@ -855,11 +1120,18 @@ namespace md
             return;
         if (!controller_->isSynced())
             return;
+        // Every applied update counts towards the cadence; updates that never reached the persisted
+        // top-N only leave the book_state unchanged, so a checkpoint with nothing new is not written.
+        if (!change || change->topChanged(persist_book_top_))
+            book_state_dirty_ = true;
 
         ++updates_since_book_persist_;
         if (updates_since_book_persist_ < persist_book_every_updates_)
             return;
         updates_since_book_persist_ = 0;
+        if (!book_state_dirty_)
+            return;
+        book_state_dirty_ = false;
 
         const auto ts_book_ns = now_ns_();
         if (persist_)
@@ -883,7 +1155,8 @@ namespace md
     // -------------------------------------------------------------------------
     // D2: per-feed heartbeat
 
-    void GenericFeedHandler::arm_heartbeat_()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::arm_heartbeat_()
     {
         constexpr int kIntervalSec = 60;
         heartbeat_timer_.expires_after(std::chrono::seconds(kIntervalSec));
@@ -895,7 +1168,8 @@ namespace md
         });
     }
 
-    void GenericFeedHandler::emit_heartbeat_()
+    template<typename Adapter>
+    void GenericFeedHandler<Adapter>::emit_heartbeat_()
     {
         constexpr int kIntervalSec = 60;
         const std::string venue = to_string(rt_.venue);
@@ -903,6 +1177,40 @@ namespace md
         const std::uint64_t msgs_per_sec = ctr_msgs_received_ / kIntervalSec;
         spdlog::info("[HEARTBEAT] venue={} state={} msgs_received={} msgs_per_sec={} book_updates={} resyncs={}",
                      venue, state, ctr_msgs_received_, msgs_per_sec, ctr_book_updates_, ctr_resyncs_);
+        if constexpr (alloc::kCounting) {
+            spdlog::info("[HEARTBEAT] venue={} update_allocs={} allocs_per_update={:.3f}",
+                         venue, ctr_update_allocs_,
+                         ctr_book_updates_ ? static_cast<double>(ctr_update_allocs_) / static_cast<double>(ctr_book_updates_) : 0.0);
+        }
+        if (ctr_rx_stamped_ > 0)
+        {
+            spdlog::info("[HEARTBEAT] venue={} kernel_to_handler_us avg={:.1f} max={:.1f} stamped={}",
+                         venue, static_cast<double>(ctr_rx_queue_ns_sum_) / static_cast<double>(ctr_rx_stamped_) / 1e3,
+                         static_cast<double>(ctr_rx_queue_ns_max_) / 1e3, ctr_rx_stamped_);
+        }
+        // Per-connection totals since the last (re)connect; wire/payload shows what deflate saves.
+        if (!rt_.arbitrate)
+        {
+            spdlog::info("[HEARTBEAT] venue={} ws {}", venue, describe(legs_.front().ws->traffic()));
+        }
+        else
+        {
+            // wins = book frames this leg delivered first, dups = frames another leg had already delivered.
+            for (std::size_t i = 0; i < legs_.size(); ++i)
+            {
+                WsLeg &leg = legs_[i];
+                spdlog::info("[HEARTBEAT] venue={} ws[{}] host={} open={} wins={} dups={} {}",
+                             venue, i, leg.ep.host, leg.open, leg.wins, leg.dups, describe(leg.ws->traffic()));
+                leg.wins = 0;
+                leg.dups = 0;
+            }
+            if (ctr_arb_held_ > 0)
+                spdlog::info("[HEARTBEAT] venue={} ws arbitration held={} (leg ahead, waited for a slower leg)",
+                             venue, ctr_arb_held_);
+            ctr_arb_held_ = 0;
+        }
+        if (brain_publish_)
+            spdlog::info("[HEARTBEAT] venue={} brain_ws {}", venue, describe(brain_publish_->traffic()));
 
         // C2: warn if rate exceeds 2× configured ceiling
         if (cfg_.max_msg_rate_per_sec > 0 &&
@@ -913,5 +1221,34 @@ namespace md
         // Reset per-interval counters; lifetime counters (resyncs) are kept
         ctr_msgs_received_ = 0;
         ctr_book_updates_  = 0;
+        ctr_update_allocs_ = 0;
+        ctr_rx_stamped_ = 0;
+        ctr_rx_queue_ns_sum_ = 0;
+        ctr_rx_queue_ns_max_ = 0;
+    }
+
+    template class GenericFeedHandler<BinanceAdapter>;
+    template class GenericFeedHandler<OKXAdapter>;
+    template class GenericFeedHandler<BitgetAdapter>;
+    template class GenericFeedHandler<BybitAdapter>;
+    template class GenericFeedHandler<KucoinAdapter>;
+
+    std::unique_ptr<IVenueFeedHandler> makeFeedHandler(VenueId v, boost::asio::io_context &ioc)
+    {
+        switch (v)
+        {
+        case VenueId::BINANCE:
+            return std::make_unique<GenericFeedHandler<BinanceAdapter>>(ioc);
+        case VenueId::OKX:
+            return std::make_unique<GenericFeedHandler<OKXAdapter>>(ioc);
+        case VenueId::BITGET:
+            return std::make_unique<GenericFeedHandler<BitgetAdapter>>(ioc);
+        case VenueId::BYBIT:
+            return std::make_unique<GenericFeedHandler<BybitAdapter>>(ioc);
+        case VenueId::KUCOIN:
+            return std::make_unique<GenericFeedHandler<KucoinAdapter>>(ioc);
+        default:
+            return std::make_unique<GenericFeedHandler<BinanceAdapter>>(ioc);
+        }
     }
 }
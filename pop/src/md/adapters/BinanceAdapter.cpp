@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <string>
 #include <nlohmann/json.hpp>
 
 #include "utils/VenueUtils.hpp"
+#include "md/BookFrame.hpp"
 #include "md/VenueAdapter.hpp"
 #include "orderbook/OrderBookUtils.hpp"
 #include "utils/DebugConfigUtils.hpp"
@@ -10,6 +12,14 @@
 using json = nlohmann::json;
 
 namespace md {
+    /// {"e":"depthUpdate","E":..,"s":..,"U":..,"u":..,"pu":..,"b":[["px","qty"],..],"a":[..]}
+    /// Subscribe reply: {"result":null,"id":1}
+    static constexpr BookFrameLayout kDepthUpdate{
+        .tagKey = "e", .eventKey = "result",
+        .firstSeqKey = "U", .seqKey = "u", .prevSeqKey = "pu",
+        .bidsKey = "b", .asksKey = "a",
+    };
+
     VenueCaps BinanceAdapter::caps() const noexcept {
         VenueCaps c;
         c.sync_mode = SyncMode::RestAnchored;
@@ -68,48 +78,36 @@ namespace md {
         const std::string rest_sym = venue::map_rest_symbol(VenueId::BINANCE, cfg.base_ccy, cfg.quote_ccy);
 
         // Binance depth limit must be one of allowed values; if you enforce later, do it upstream.
-        return "/api/v3/depth?symbol=" + rest_sym + "&limit=" + std::to_string(cfg.depthLevel);
-    }
-
-    bool BinanceAdapter::isIncremental(std::string_view msg) const noexcept {
-        return msg.find("depthUpdate") != std::string_view::npos;
+        // The reserve band is requested as well so the snapshot fills it (REST max is 5000).
+        const std::size_t limit = std::min<std::size_t>(cfg.depthLevel + cfg.book.reserve_levels, 5000);
+        return "/api/v3/depth?symbol=" + rest_sym + "&limit=" + std::to_string(limit);
     }
 
-    bool BinanceAdapter::parseIncremental(std::string_view msg, GenericIncrementalFormat &update) const {
+    /**
+     * Hot path: one forward scan over the frame along kDepthUpdate (see BookFrame.hpp), no DOM. Sequence ids and levels are
+     * written straight into 'update'; with a reused 'update' the vectors keep their capacity and the
+     * level text is viewed in place in the frame (no copy), so a steady-state frame does not allocate.
+     * Binance sends no WS snapshots; 'snap' is never touched.
+     */
+    FrameKind BinanceAdapter::classifyAndParse(std::string_view msg, GenericSnapshotFormat &,
+                                               GenericIncrementalFormat &update) const {
         update.reset();
 
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
+        BookFrame f;
+        if (!scanBookFrame(msg, kDepthUpdate, f, update.bids, update.asks)) {
             if (debug::dbg_on()) {
-                spdlog::debug("[BINANCE][SNAPSHOT] json parse failed");
+                spdlog::debug("[BINANCE][INC] frame scan failed");
                 debug::dbg_raw(msg);
             }
-            return false;
+            return FrameKind::Ignore;
         }
+        if (f.tag != "depthUpdate") return f.event.empty() ? FrameKind::Ignore : FrameKind::SubscribeAck;
+        if (!f.firstSeq || !f.seq || !f.hasBids || !f.hasAsks) return FrameKind::Ignore;
 
-        if (!j.contains("e") || j["e"] != "depthUpdate") return false;
-        if (!j.contains("U") || !j.contains("u") || !j.contains("b") || !j.contains("a")) return false;
-
-        update.first_seq = j["U"].get<std::uint64_t>();
-        update.last_seq = j["u"].get<std::uint64_t>();
+        update.first_seq = static_cast<std::uint64_t>(*f.firstSeq);
+        update.last_seq = static_cast<std::uint64_t>(*f.seq);
         const auto fallback_prev = (update.last_seq > 0) ? (update.last_seq - 1) : 0;
-        update.prev_last = j.value("pu", fallback_prev);
-
-        const auto &b = j["b"];
-        const auto &a = j["a"];
-        update.bids.reserve(b.size());
-        update.asks.reserve(a.size());
-
-        for (const auto &lvl: b) {
-            const auto &px = lvl[0].get_ref<const std::string &>();
-            const auto &qt = lvl[1].get_ref<const std::string &>();
-            update.bids.push_back(Level{md::parsePriceToTicks(px), md::parseQtyToLots(qt), px, qt});
-        }
-        for (const auto &lvl: a) {
-            const auto &px = lvl[0].get_ref<const std::string &>();
-            const auto &qt = lvl[1].get_ref<const std::string &>();
-            update.asks.push_back(Level{md::parsePriceToTicks(px), md::parseQtyToLots(qt), px, qt});
-        }
+        update.prev_last = f.prevSeq ? static_cast<std::uint64_t>(*f.prevSeq) : fallback_prev;
 
         if (debug::dbg_on()) {
             static std::uint64_t inc_cnt = 0;
@@ -124,7 +122,7 @@ namespace md {
             }
         }
 
-        return true;
+        return FrameKind::Incremental;
     }
 
     bool BinanceAdapter::parseSnapshot(std::string_view body, GenericSnapshotFormat &snap) const {
@@ -143,16 +141,20 @@ namespace md {
 
             snap.lastUpdateId = j["lastUpdateId"].get<std::uint64_t>();
 
+            // The DOM dies with this call: level text is copied into the snapshot's arena.
+
             for (const auto &b: j["bids"]) {
                 const auto &px_str = b[0].get_ref<const std::string &>();
                 const auto &qty_str = b[1].get_ref<const std::string &>();
-                snap.bids.push_back(Level{parsePriceToTicks(px_str), parseQtyToLots(qty_str), px_str, qty_str});
+                snap.bids.push_back(Level{parsePriceToTicks(px_str), parseQtyToLots(qty_str),
+                                         snap.text.store(px_str), snap.text.store(qty_str)});
             }
 
             for (const auto &a: j["asks"]) {
                 const auto &px_str = a[0].get_ref<const std::string &>();
                 const auto &qty_str = a[1].get_ref<const std::string &>();
-                snap.asks.push_back(Level{parsePriceToTicks(px_str), parseQtyToLots(qty_str), px_str, qty_str});
+                snap.asks.push_back(Level{parsePriceToTicks(px_str), parseQtyToLots(qty_str),
+                                         snap.text.store(px_str), snap.text.store(qty_str)});
             }
 
             if (debug::dbg_on()) {
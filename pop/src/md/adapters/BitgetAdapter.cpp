@@ -1,6 +1,7 @@
 #include <nlohmann/json.hpp>
 
 #include "utils/VenueUtils.hpp"
+#include "md/BookFrame.hpp"
 #include "md/VenueAdapter.hpp"
 #include "orderbook/OrderBookUtils.hpp"
 #include "utils/DebugConfigUtils.hpp"
@@ -14,8 +15,8 @@ namespace md {
         c.sync_mode = SyncMode::WsAuthoritative;
         c.ws_sends_snapshot = true;
 
-        c.has_checksum = false;
-        // Bitget CRC32 checksum validation is disabled for the following reasons:
+        c.has_checksum = true;
+        // Bitget CRC32 checksum validation is opt-in (--require_checksum):
         //
         //   1. The initial WS snapshot rarely includes a checksum, so the baseline
         //      is accepted as best-effort (no CRC32 to anchor against).
@@ -29,8 +30,10 @@ namespace md {
         //   3. Structural integrity is ensured by C1 (crossed-book guard),
         //      B3 (tick/quantity sanity), and C3 (periodic OrderBook::validate()).
         //
-        // Re-enable when a REST snapshot is used as the verified baseline.
-        c.checksum_fn = nullptr;
+        // Make it the default when a REST snapshot is used as the verified baseline.
+        c.checksum_fn = checkInterleavedCRC32;
+        c.checksum_incremental = true;
+        c.checksum_opt_in = true;
         c.checksum_top_n = 25;
 
         c.can_backfill = false;
@@ -73,71 +76,23 @@ namespace md {
         return "";
     }
 
-    static bool looksLikeBitgetBooks(std::string_view msg) noexcept {
-        return msg.find("\"channel\":\"books") != std::string_view::npos
-               && msg.find("\"data\"") != std::string_view::npos;
-    }
-
-    bool BitgetAdapter::isSnapshot(std::string_view msg) const noexcept {
-        if (!looksLikeBitgetBooks(msg))
-            return false;
-        return msg.find("\"action\":\"snapshot\"") != std::string_view::npos;
-    }
-
-    bool BitgetAdapter::isIncremental(std::string_view msg) const noexcept {
-        if (!looksLikeBitgetBooks(msg)) return false;
-        return msg.find("\"action\":\"update\"") != std::string_view::npos;
-    }
-
-    static void parseLevels2col(const json &arr, std::vector<Level> &out) {
-        out.clear();
-        if (!arr.is_array()) return;
-        out.reserve(arr.size());
-        for (const auto &lvl: arr) {
-            if (!lvl.is_array() || lvl.size() < 2) continue;
-            const auto &px = lvl[0].get_ref<const std::string &>();
-            const auto &qt = lvl[1].get_ref<const std::string &>();
-            out.push_back(Level{parsePriceToTicks(px), parseQtyToLots(qt), px, qt});
-        }
-    }
-
-    bool BitgetAdapter::parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &out) const {
-        out.reset();
-
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
-            if (debug::dbg_on()) {
-                spdlog::debug("[BITGET][SNAPSHOT] json parse failed");
-                debug::dbg_raw(msg);
-            }
-            return false;
-        }
-
-        if (j.value("action", "") != "snapshot") return false;
-        if (!j.contains("data") || !j["data"].is_array() || j["data"].empty()) return false;
+    /// {"action":"snapshot"|"update","arg":{..},"data":[{"asks":[["px","sz"],..],"bids":[..],
+    ///  "checksum":n,"seq":n,"ts":".."}],"ts":..}
+    /// Control: {"event":"subscribe","arg":{..}}, {"event":"error",..}, text "pong"
+    static constexpr BookFrameLayout kBitgetBooks{
+        .tagKey = "action", .eventKey = "event",
+        .dataKey = "data", .dataIsArray = true,
+        .seqKey = "seq", .checksumKey = "checksum",
+        .bidsKey = "bids", .asksKey = "asks",
+    };
 
-        const auto &d0 = j["data"][0];
-        if (!d0.contains("bids") || !d0.contains("asks")) return false;
+    static bool finishWsSnapshot(const BookFrame &f, std::string_view msg, GenericSnapshotFormat &out) {
+        if (!f.hasBids || !f.hasAsks) return false;
 
         // seq (Long) -> lastUpdateId anchor (preferred over ts)
-        if (d0.contains("seq")) {
-            std::uint64_t seq_u64{};
-            if (json_to_u64_flexible(d0["seq"], seq_u64)) {
-                out.lastUpdateId = seq_u64;
-            }
-        }
+        if (f.seq && *f.seq >= 0) out.lastUpdateId = static_cast<std::uint64_t>(*f.seq);
 
-        // checksum
-        if (d0.contains("checksum")) {
-            if (d0["checksum"].is_string()) out.checksum = std::stoll(d0["checksum"].get<std::string>());
-            else out.checksum = d0["checksum"].get<std::int64_t>();
-        } else if (j.contains("checksum")) {
-            if (j["checksum"].is_string()) out.checksum = std::stoll(j["checksum"].get<std::string>());
-            else out.checksum = j["checksum"].get<std::int64_t>();
-        }
-
-        parseLevels2col(d0["bids"], out.bids);
-        parseLevels2col(d0["asks"], out.asks);
+        out.checksum = f.checksum.value_or(0);
 
         if (debug::dbg_on()) {
             static std::uint64_t snap_cnt = 0;
@@ -154,44 +109,19 @@ namespace md {
         return true;
     }
 
-    bool BitgetAdapter::parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const {
-        out.reset();
-
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
-            if (debug::dbg_on()) {
-                spdlog::debug("[BITGET][INC] json parse failed");
-                debug::dbg_raw(msg);
-            }
-            return false;
-        }
-
-        if (j.value("action", "") != "update") return false;
-        if (!j.contains("data") || !j["data"].is_array() || j["data"].empty()) return false;
-
-        const auto &d0 = j["data"][0];
-        if (!d0.contains("bids") || !d0.contains("asks")) return false;
+    static bool finishIncremental(const BookFrame &f, std::string_view msg, GenericIncrementalFormat &out) {
+        if (!f.hasBids || !f.hasAsks) return false;
 
         // seq (Long): treat as single-step sequence
-        if (d0.contains("seq")) {
-            std::uint64_t seq_u64{};
-            if (json_to_u64_flexible(d0["seq"], seq_u64)) {
-                out.first_seq = seq_u64;
-                out.last_seq = seq_u64;
-                out.prev_last = (seq_u64 > 0) ? (seq_u64 - 1) : 0;
-            }
+        if (f.seq && *f.seq >= 0) {
+            const auto seq = static_cast<std::uint64_t>(*f.seq);
+            out.first_seq = seq;
+            out.last_seq = seq;
+            out.prev_last = (seq > 0) ? (seq - 1) : 0;
         }
 
         // checksum (Long)
-        if (d0.contains("checksum")) {
-            std::int64_t c{};
-            if (json_to_i64_flexible(d0["checksum"], c)) {
-                out.checksum = c;
-            }
-        }
-
-        parseLevels2col(d0["bids"], out.bids);
-        parseLevels2col(d0["asks"], out.asks);
+        out.checksum = f.checksum.value_or(0);
 
         if (debug::dbg_on()) {
             static std::uint64_t inc_cnt = 0;
@@ -208,4 +138,31 @@ namespace md {
 
         return true;
     }
+
+    /// One scan along kBitgetBooks; levels go to 'inc' and move to 'snap' for a snapshot.
+    FrameKind BitgetAdapter::classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                              GenericIncrementalFormat &inc) const {
+        if (msg == "pong") return FrameKind::Pong; // reply to a text "ping"
+
+        inc.reset();
+
+        BookFrame f;
+        if (!scanBookFrame(msg, kBitgetBooks, f, inc.bids, inc.asks)) {
+            if (debug::dbg_on()) {
+                spdlog::debug("[BITGET] frame scan failed");
+                debug::dbg_raw(msg);
+            }
+            return FrameKind::Ignore;
+        }
+
+        if (f.tag == "update")
+            return finishIncremental(f, msg, inc) ? FrameKind::Incremental : FrameKind::Ignore;
+        if (f.tag == "snapshot") {
+            snap.reset();
+            takeSnapshotLevels(inc, snap);
+            return finishWsSnapshot(f, msg, snap) ? FrameKind::Snapshot : FrameKind::Ignore;
+        }
+        if (f.event == "subscribe") return FrameKind::SubscribeAck;
+        return FrameKind::Ignore;
+    }
 } // namespace md
@@ -1,6 +1,7 @@
 #include <nlohmann/json.hpp>
 
 #include "utils/VenueUtils.hpp"
+#include "md/BookFrame.hpp"
 #include "md/VenueAdapter.hpp"
 #include "orderbook/OrderBookUtils.hpp"
 #include "utils/DebugConfigUtils.hpp"
@@ -59,54 +60,25 @@ namespace md {
         return "";
     }
 
-    bool BybitAdapter::isSnapshot(std::string_view msg) const noexcept {
-        return msg.find("\"type\":\"snapshot\"") != std::string_view::npos;
-    }
-
-    bool BybitAdapter::isIncremental(std::string_view msg) const noexcept {
-        return msg.find("\"type\":\"delta\"") != std::string_view::npos;
-    }
+    /// {"topic":"orderbook.50.BTCUSDT","type":"snapshot"|"delta","ts":..,
+    ///  "data":{"s":"BTCUSDT","b":[["px","sz"],..],"a":[..],"u":n,"seq":n},"cts":..}
+    /// Control: {"success":true,"ret_msg":"","op":"subscribe",..}; pong: {"op":"ping"|"pong",..}
+    static constexpr BookFrameLayout kBybitOrderbook{
+        .tagKey = "type", .eventKey = "op",
+        .dataKey = "data",
+        .seqKey = "u",
+        .bidsKey = "b", .asksKey = "a",
+    };
 
-    static void parseLevels2col_bybit(const json &arr, std::vector<Level> &out) {
-        out.clear();
-        if (!arr.is_array()) return;
-        out.reserve(arr.size());
-
-        for (const auto &lvl: arr) {
-            if (!lvl.is_array() || lvl.size() < 2) continue;
-            const auto &px = lvl[0].get_ref<const std::string &>();
-            const auto &sz = lvl[1].get_ref<const std::string &>();
-            out.push_back(Level{md::parsePriceToTicks(px), md::parseQtyToLots(sz), px, sz});
-        }
-    }
-
-    bool BybitAdapter::parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &out) const {
-        out.reset();
-
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
-            if (debug::dbg_on()) {
-                spdlog::debug("[BYBIT][SNAPSHOT] json parse failed");
-                debug::dbg_raw(msg);
-            }
-            return false;
-        }
-
-        if (j.value("type", "") != "snapshot") return false;
-        if (!j.contains("data") || !j["data"].is_object()) return false;
-
-        const auto &d = j["data"];
+    static bool finishWsSnapshot(const BookFrame &f, std::string_view msg, GenericSnapshotFormat &out) {
 
         // Bybit orderbook update id
-        if (!d.contains("u")) return false;
-        out.lastUpdateId = d["u"].get<std::uint64_t>();
+        if (!f.seq) return false;
+        out.lastUpdateId = static_cast<std::uint64_t>(*f.seq);
 
         // No checksum in Bybit v5 orderbook
         out.checksum = 0;
 
-        if (d.contains("b")) parseLevels2col_bybit(d["b"], out.bids);
-        if (d.contains("a")) parseLevels2col_bybit(d["a"], out.asks);
-
         if (debug::dbg_on()) {
             static std::uint64_t snap_cnt = 0;
             ++snap_cnt;
@@ -121,25 +93,9 @@ namespace md {
         return true;
     }
 
-    bool BybitAdapter::parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const {
-        out.reset();
-
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
-            if (debug::dbg_on()) {
-                spdlog::debug("[BYBIT][INC] json parse failed");
-                debug::dbg_raw(msg);
-            }
-            return false;
-        }
-
-        if (j.value("type", "") != "delta") return false;
-        if (!j.contains("data") || !j["data"].is_object()) return false;
-
-        const auto &d = j["data"];
-
-        if (!d.contains("u")) return false;
-        const std::uint64_t u = d["u"].get<std::uint64_t>();
+    static bool finishIncremental(const BookFrame &f, std::string_view msg, GenericIncrementalFormat &out) {
+        if (!f.seq) return false;
+        const auto u = static_cast<std::uint64_t>(*f.seq);
 
         // Map to your generic seq fields as a single-id update:
         out.first_seq = u;
@@ -147,9 +103,6 @@ namespace md {
         out.prev_last = (u > 0) ? (u - 1) : 0;
         out.checksum = 0;
 
-        if (d.contains("b")) parseLevels2col_bybit(d["b"], out.bids);
-        if (d.contains("a")) parseLevels2col_bybit(d["a"], out.asks);
-
         if (debug::dbg_on()) {
             static std::uint64_t inc_cnt = 0;
             if (debug::dbg_sample(inc_cnt)) {
@@ -165,4 +118,30 @@ namespace md {
 
         return true;
     }
+
+    /// One scan along kBybitOrderbook; levels go to 'inc' and move to 'snap' for a snapshot.
+    FrameKind BybitAdapter::classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                             GenericIncrementalFormat &inc) const {
+        inc.reset();
+
+        BookFrame f;
+        if (!scanBookFrame(msg, kBybitOrderbook, f, inc.bids, inc.asks)) {
+            if (debug::dbg_on()) {
+                spdlog::debug("[BYBIT] frame scan failed");
+                debug::dbg_raw(msg);
+            }
+            return FrameKind::Ignore;
+        }
+
+        if (f.tag == "delta")
+            return finishIncremental(f, msg, inc) ? FrameKind::Incremental : FrameKind::Ignore;
+        if (f.tag == "snapshot") {
+            snap.reset();
+            takeSnapshotLevels(inc, snap);
+            return finishWsSnapshot(f, msg, snap) ? FrameKind::Snapshot : FrameKind::Ignore;
+        }
+        if (f.event == "ping" || f.event == "pong") return FrameKind::Pong;
+        if (f.event == "subscribe") return FrameKind::SubscribeAck;
+        return FrameKind::Ignore;
+    }
 }
@@ -1,6 +1,7 @@
 #include <nlohmann/json.hpp>
 
 #include "utils/VenueUtils.hpp"
+#include "md/BookFrame.hpp"
 #include "md/VenueAdapter.hpp"
 #include "orderbook/OrderBookUtils.hpp"
 #include "utils/DebugConfigUtils.hpp"
@@ -9,63 +10,22 @@
 using json = nlohmann::json;
 
 namespace md {
-    static bool is_num_or_str(const json &j) noexcept {
-        return j.is_number_integer() || j.is_number_unsigned() || j.is_string();
-    }
-
-    static bool as_u64(const json &j, std::uint64_t &out) noexcept {
-        try {
-            if (j.is_string()) {
-                const std::string s = j.get<std::string>();
-                if (s.empty() || s[0] == '-') return false;
-                std::size_t pos = 0;
-                const auto v = std::stoull(s, &pos);
-                if (pos != s.size()) return false;
-                out = v;
-                return true;
-            }
-            if (j.is_number_unsigned()) {
-                out = j.get<std::uint64_t>();
-                return true;
-            }
-            if (j.is_number_integer()) {
-                const auto v = j.get<std::int64_t>();
-                if (v < 0) return false;
-                out = static_cast<std::uint64_t>(v);
-                return true;
-            }
-            return false;
-        } catch (...) {
-            return false;
-        }
-    }
-
-    static void parseLevels2col(const json &arr, std::vector<Level> &out) {
-        // KuCoin REST bids/asks typically: [["price","size"], ...]
-        // KuCoin WS changes bids/asks typically: [["price","size","seq"], ...]
-        out.clear();
-        if (!arr.is_array()) return;
-
-        out.reserve(arr.size());
-        for (const auto &lvl: arr) {
-            if (!lvl.is_array() || lvl.size() < 2) continue;
-
-            // price/size are strings in docs; be defensive
-            std::string px, sz;
-            if (lvl[0].is_string()) px = lvl[0].get<std::string>();
-            else px = lvl[0].dump();
-
-            if (lvl[1].is_string()) sz = lvl[1].get<std::string>();
-            else sz = lvl[1].dump();
-
-            out.push_back(Level{
-                md::parsePriceToTicks(px),
-                md::parseQtyToLots(sz),
-                px,
-                sz
-            });
-        }
-    }
+    /// REST: {"code":"200000","data":{"time":..,"sequence":"n","bids":[["px","sz"],..],"asks":[..]}}
+    static constexpr BookFrameLayout kKucoinRestBook{
+        .dataKey = "data",
+        .seqKey = "sequence",
+        .bidsKey = "bids", .asksKey = "asks",
+    };
+
+    /// WS: {"type":"message","topic":"/market/level2:BTC-USDT","subject":"trade.l2update",
+    ///      "data":{"changes":{"asks":[["px","sz","seq"],..],"bids":[..]},"sequenceEnd":n,"sequenceStart":n,..}}
+    /// Control: {"id":"..","type":"welcome"|"ack"|"pong"}
+    static constexpr BookFrameLayout kKucoinL2Update{
+        .tagKey = "type", .subjectKey = "subject",
+        .dataKey = "data",
+        .firstSeqKey = "sequenceStart", .seqKey = "sequenceEnd",
+        .levelsKey = "changes", .bidsKey = "bids", .asksKey = "asks",
+    };
 
     static bool parse_wss_endpoint(std::string_view endpoint,
                                    std::string &out_host,
@@ -227,36 +187,21 @@ namespace md {
         return "/api/v1/market/orderbook/level2_" + std::to_string(size) + "?symbol=" + sym;
     }
 
-    bool KucoinAdapter::isIncremental(std::string_view msg) const noexcept {
-        // cheap prefilter
-        // Example message: {"type":"message","topic":"/market/level2:BTC-USDT","subject":"trade.l2update","data":{...}}
-        if (msg.find("\"type\":\"message\"") == std::string_view::npos) return false;
-        if (msg.find("\"subject\":\"trade.l2update\"") == std::string_view::npos) return false;
-        if (msg.find("\"/market/level2:") == std::string_view::npos) return false;
-        return true;
-    }
-
     bool KucoinAdapter::parseSnapshot(std::string_view msg, GenericSnapshotFormat &out) const {
         out.reset();
 
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
+        BookFrame f;
+        if (!scanBookFrame(msg, kKucoinRestBook, f, out.bids, out.asks)) {
             if (debug::dbg_on()) {
-                spdlog::debug("[KUCOIN][SNAPSHOT] json parse failed");
+                spdlog::debug("[KUCOIN][SNAPSHOT] frame scan failed");
                 debug::dbg_raw(msg);
             }
             return false;
         }
 
-        if (!j.contains("data")) return false;
-        const auto &d = j["data"];
-
-        // data.sequence can be string (commonly) — be defensive
-        if (!d.contains("sequence") || !is_num_or_str(d["sequence"])) return false;
-        if (!as_u64(d["sequence"], out.lastUpdateId)) return false;
-
-        if (d.contains("bids")) parseLevels2col(d["bids"], out.bids);
-        if (d.contains("asks")) parseLevels2col(d["asks"], out.asks);
+        // data.sequence can be string (commonly) or number
+        if (!f.seq || *f.seq < 0) return false;
+        out.lastUpdateId = static_cast<std::uint64_t>(*f.seq);
 
         if (debug::dbg_on()) {
             static std::uint64_t snap_cnt = 0;
@@ -272,36 +217,30 @@ namespace md {
         return true;
     }
 
-    bool KucoinAdapter::parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const {
+    /// KuCoin sends no WS snapshots (REST-anchored); 'snap' is never touched.
+    FrameKind KucoinAdapter::classifyAndParse(std::string_view msg, GenericSnapshotFormat &,
+                                              GenericIncrementalFormat &out) const {
         out.reset();
 
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
+        BookFrame f;
+        if (!scanBookFrame(msg, kKucoinL2Update, f, out.bids, out.asks)) {
             if (debug::dbg_on()) {
-                spdlog::debug("[KUCOIN][INC] json parse failed");
+                spdlog::debug("[KUCOIN][INC] frame scan failed");
                 debug::dbg_raw(msg);
             }
-            return false;
+            return FrameKind::Ignore;
         }
 
-        if (j.value("type", "") != "message") return false;
-        if (j.value("subject", "") != "trade.l2update") return false;
-        if (!j.contains("data")) return false;
-
-        const auto &d = j["data"];
+        if (f.tag == "pong") return FrameKind::Pong;
+        if (f.tag == "welcome" || f.tag == "ack") return FrameKind::SubscribeAck;
+        if (f.tag != "message" || f.subject != "trade.l2update") return FrameKind::Ignore;
 
-        if (!d.contains("sequenceStart") || !d.contains("sequenceEnd")) return false;
-        if (!is_num_or_str(d["sequenceStart"]) || !is_num_or_str(d["sequenceEnd"])) return false;
-
-        if (!as_u64(d["sequenceStart"], out.first_seq)) return false;
-        if (!as_u64(d["sequenceEnd"], out.last_seq)) return false;
+        if (!f.firstSeq || !f.seq || *f.firstSeq < 0 || *f.seq < 0) return FrameKind::Ignore;
+        out.first_seq = static_cast<std::uint64_t>(*f.firstSeq);
+        out.last_seq = static_cast<std::uint64_t>(*f.seq);
         out.prev_last = (out.first_seq > 0) ? (out.first_seq - 1) : 0;
 
-        if (!d.contains("changes")) return false;
-        const auto &ch = d["changes"];
-
-        if (ch.contains("bids")) parseLevels2col(ch["bids"], out.bids);
-        if (ch.contains("asks")) parseLevels2col(ch["asks"], out.asks);
+        if (!f.hasBids && !f.hasAsks) return FrameKind::Ignore; // no "changes"
 
         if (debug::dbg_on()) {
             static std::uint64_t inc_cnt = 0;
@@ -316,6 +255,6 @@ namespace md {
             }
         }
 
-        return true;
+        return FrameKind::Incremental;
     }
 }
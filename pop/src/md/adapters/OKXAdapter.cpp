@@ -1,6 +1,7 @@
 #include <nlohmann/json.hpp>
 
 #include "utils/VenueUtils.hpp"
+#include "md/BookFrame.hpp"
 #include "md/VenueAdapter.hpp"
 #include "orderbook/OrderBookUtils.hpp"
 #include "utils/DebugConfigUtils.hpp"
@@ -13,10 +14,13 @@ namespace md {
         VenueCaps c;
         c.sync_mode = SyncMode::WsAuthoritative;
         c.ws_sends_snapshot = true;
-        // TODO: Revisit OKX checksum/snapshot assumptions when exchange-side
-        // deprecation rollout completes; prefer seq-based integrity if checksum
-        // is removed from the feed.
+        // Validated on every frame; a frame without the checksum field resyncs. If OKX
+        // completes the deprecation of the field, move this venue to seq-based integrity.
+        // The handler turns validation off when depthLevel is below the checksummed top-25.
         c.has_checksum = true;
+        c.checksum_fn = checkInterleavedCRC32;
+        c.checksum_incremental = true;
+        c.checksum_top_n = 25;
         c.can_backfill = false;
         return c;
     }
@@ -56,67 +60,20 @@ namespace md {
         return "/api/v5/market/books?instId=" + instId + "&sz=" + std::to_string(sz);
     }
 
-    static bool looksLikeOKXBooks(std::string_view msg) noexcept {
-        // cheap prefilter (replace with simdjson later)
-        return msg.find("\"channel\":\"books") != std::string_view::npos
-               && msg.find("\"data\"") != std::string_view::npos;
-    }
-
-    bool OKXAdapter::isSnapshot(std::string_view msg) const noexcept {
-        if (!looksLikeOKXBooks(msg)) return false;
-        return msg.find("\"action\":\"snapshot\"") != std::string_view::npos;
-    }
-
-    bool OKXAdapter::isIncremental(std::string_view msg) const noexcept {
-        if (!looksLikeOKXBooks(msg)) return false;
-        return msg.find("\"action\":\"update\"") != std::string_view::npos;
-    }
-
-    static void parseLevels2col(const json &arr, std::vector<Level> &out) {
-        // OKX asks/bids entries look like ["8476.98","415","0","13"]
-        out.clear();
-        if (!arr.is_array()) return;
-        out.reserve(arr.size());
-        for (const auto &lvl: arr) {
-            if (!lvl.is_array() || lvl.size() < 2) continue;
-            const auto &px = lvl[0].get_ref<const std::string &>();
-            const auto &sz = lvl[1].get_ref<const std::string &>();
-            out.push_back(Level{md::parsePriceToTicks(px), md::parseQtyToLots(sz), px, sz});
-        }
-    }
-
-    bool OKXAdapter::parseWsSnapshot(std::string_view msg, GenericSnapshotFormat &out) const {
-        out.reset();
-
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
-            if (debug::dbg_on()) {
-                spdlog::debug("[OKX][SNAPSHOT] json parse failed");
-                debug::dbg_raw(msg);
-            }
-            return false;
-        }
-
-        if (j.value("action", "") != "snapshot") return false;
-        if (!j.contains("data") || !j["data"].is_array() || j["data"].empty()) return false;
-
-        const auto &d0 = j["data"][0];
-
-        if (!d0.contains("seqId")) return false;
-        out.lastUpdateId = d0["seqId"].get<std::uint64_t>();
-
-        // NEW: checksum (prefer data[0], fallback to top-level if ever present)
-        if (d0.contains("checksum")) {
-            // checksum sometimes comes as number; if string, handle below
-            if (d0["checksum"].is_string()) out.checksum = std::stoll(d0["checksum"].get<std::string>());
-            else out.checksum = d0["checksum"].get<std::int64_t>();
-        } else if (j.contains("checksum")) {
-            if (j["checksum"].is_string()) out.checksum = std::stoll(j["checksum"].get<std::string>());
-            else out.checksum = j["checksum"].get<std::int64_t>();
-        }
-
-        if (d0.contains("bids")) parseLevels2col(d0["bids"], out.bids);
-        if (d0.contains("asks")) parseLevels2col(d0["asks"], out.asks);
+    /// {"arg":{..},"action":"snapshot"|"update","data":[{"asks":[["px","sz","0","n"],..],"bids":[..],
+    ///  "ts":"..","checksum":n,"prevSeqId":n,"seqId":n}]}
+    /// Control: {"event":"subscribe","arg":{..},"connId":".."}, {"event":"error",..}, text "pong"
+    static constexpr BookFrameLayout kOkxBooks{
+        .tagKey = "action", .eventKey = "event",
+        .dataKey = "data", .dataIsArray = true,
+        .seqKey = "seqId", .prevSeqKey = "prevSeqId", .checksumKey = "checksum",
+        .bidsKey = "bids", .asksKey = "asks",
+    };
+
+    static bool finishWsSnapshot(const BookFrame &f, std::string_view msg, GenericSnapshotFormat &out) {
+        if (!f.seq) return false;
+        out.lastUpdateId = static_cast<std::uint64_t>(*f.seq);
+        out.checksum = f.checksum.value_or(0);
 
         if (debug::dbg_on()) {
             static std::uint64_t snap_cnt = 0;
@@ -133,43 +90,13 @@ namespace md {
         return true;
     }
 
-    bool OKXAdapter::parseIncremental(std::string_view msg, GenericIncrementalFormat &out) const {
-        out.reset();
-
-        json j = json::parse(msg.begin(), msg.end(), nullptr, false);
-        if (j.is_discarded()) {
-            if (debug::dbg_on()) {
-                spdlog::debug("[OKX][INC] json parse failed");
-                debug::dbg_raw(msg);
-            }
-            return false;
-        }
-
-        if (j.value("action", "") != "update") return false;
-        if (!j.contains("data") || !j["data"].is_array() || j["data"].empty()) return false;
-
-        const auto &d0 = j["data"][0];
+    static bool finishIncremental(const BookFrame &f, std::string_view msg, GenericIncrementalFormat &out) {
+        if (!f.seq || !f.prevSeq) return false;
 
-        if (!d0.contains("seqId") || !d0.contains("prevSeqId")) return false;
-
-        const std::int64_t prev = d0["prevSeqId"].get<std::int64_t>();
-        const std::uint64_t seq = d0["seqId"].get<std::uint64_t>();
-
-        out.prev_last = (prev < 0) ? 0ULL : static_cast<std::uint64_t>(prev);
-        out.last_seq = seq;
+        out.prev_last = (*f.prevSeq < 0) ? 0ULL : static_cast<std::uint64_t>(*f.prevSeq);
+        out.last_seq = static_cast<std::uint64_t>(*f.seq);
         out.first_seq = out.prev_last + 1;
-
-        // NEW: checksum
-        if (d0.contains("checksum")) {
-            if (d0["checksum"].is_string()) out.checksum = std::stoll(d0["checksum"].get<std::string>());
-            else out.checksum = d0["checksum"].get<std::int64_t>();
-        } else if (j.contains("checksum")) {
-            if (j["checksum"].is_string()) out.checksum = std::stoll(j["checksum"].get<std::string>());
-            else out.checksum = j["checksum"].get<std::int64_t>();
-        }
-
-        if (d0.contains("bids")) parseLevels2col(d0["bids"], out.bids);
-        if (d0.contains("asks")) parseLevels2col(d0["asks"], out.asks);
+        out.checksum = f.checksum.value_or(0);
 
         if (debug::dbg_on()) {
             static std::uint64_t inc_cnt = 0;
@@ -186,4 +113,31 @@ namespace md {
 
         return true;
     }
+
+    /// One scan along kOkxBooks; levels go to 'inc' and move to 'snap' for a snapshot.
+    FrameKind OKXAdapter::classifyAndParse(std::string_view msg, GenericSnapshotFormat &snap,
+                                           GenericIncrementalFormat &inc) const {
+        if (msg == "pong") return FrameKind::Pong; // reply to a text "ping"
+
+        inc.reset();
+
+        BookFrame f;
+        if (!scanBookFrame(msg, kOkxBooks, f, inc.bids, inc.asks)) {
+            if (debug::dbg_on()) {
+                spdlog::debug("[OKX] frame scan failed");
+                debug::dbg_raw(msg);
+            }
+            return FrameKind::Ignore;
+        }
+
+        if (f.tag == "update")
+            return finishIncremental(f, msg, inc) ? FrameKind::Incremental : FrameKind::Ignore;
+        if (f.tag == "snapshot") {
+            snap.reset();
+            takeSnapshotLevels(inc, snap);
+            return finishWsSnapshot(f, msg, snap) ? FrameKind::Snapshot : FrameKind::Ignore;
+        }
+        if (f.event == "subscribe") return FrameKind::SubscribeAck;
+        return FrameKind::Ignore;
+    }
 } // namespace md
@@ -53,8 +53,8 @@ namespace md {
         nlohmann::json arr = nlohmann::json::array();
         for (const auto &lvl: levels) {
             arr.push_back({
-                {"price", lvl.price},
-                {"quantity", lvl.quantity},
+                {"price", std::string(lvl.price)},
+                {"quantity", std::string(lvl.quantity)},
                 {"priceTick", lvl.priceTick},
                 {"quantityLot", lvl.quantityLot}
             });
@@ -65,11 +65,13 @@ namespace md {
     nlohmann::json FilePersistSink::levels_from_book_(const OrderBook &book, std::size_t top_n, Side side) {
         nlohmann::json arr = nlohmann::json::array();
         for (std::size_t i = 0; i < top_n; ++i) {
-            const Level *lvl = (side == Side::BID) ? book.bid_ptr(i) : book.ask_ptr(i);
+            const BookLevel *lvl = (side == Side::BID) ? book.bid_ptr(i) : book.ask_ptr(i);
             if (!lvl) break;
+            // Text comes from the book's cold side table (retained by the feed handler when sinks are on).
+            const LevelText *txt = (side == Side::BID) ? book.bid_text(i) : book.ask_text(i);
             arr.push_back({
-                {"price", lvl->price},
-                {"quantity", lvl->quantity},
+                {"price", txt ? txt->price : std::string{}},
+                {"quantity", txt ? txt->quantity : std::string{}},
                 {"priceTick", lvl->priceTick},
                 {"quantityLot", lvl->quantityLot}
             });
@@ -127,6 +129,7 @@ namespace md {
         j["symbol"] = symbol_;
         j["persist_seq"] = ++persist_seq_;
         j["ts_recv_ns"] = snap.ts_recv_ns;
+        if (snap.ts_recv_kernel_ns) j["ts_recv_kernel_ns"] = snap.ts_recv_kernel_ns;
         j["ts_persist_ns"] = ts_persist_ns;
         j["seq_first"] = snap.lastUpdateId;
         j["seq_last"] = snap.lastUpdateId;
@@ -146,6 +149,7 @@ namespace md {
         j["symbol"] = symbol_;
         j["persist_seq"] = ++persist_seq_;
         j["ts_recv_ns"] = inc.ts_recv_ns;
+        if (inc.ts_recv_kernel_ns) j["ts_recv_kernel_ns"] = inc.ts_recv_kernel_ns;
         j["ts_persist_ns"] = ts_persist_ns;
         j["seq_first"] = inc.first_seq;
         j["seq_last"] = inc.last_seq;
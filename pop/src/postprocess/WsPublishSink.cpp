@@ -22,7 +22,9 @@ namespace md {
                                  std::string venue,
                                  std::string symbol,
                                  std::string client_certfile,
-                                 std::string client_keyfile)
+                                 std::string client_keyfile,
+                                 WsDeflateOptions deflate,
+                                 const SocketOptions &socket_opts)
         : ioc_(ioc),
           ws_(WsClient::create(ioc)),
           reconnect_timer_(ioc),
@@ -37,6 +39,8 @@ namespace md {
         ws_->set_tls_verify_peer(!insecure_tls);
         // If brain is down or slow, keep memory bounded; prefer freshest updates.
         ws_->set_max_outbox(kDefaultMaxOutbox);
+        ws_->set_deflate(deflate);
+        ws_->set_socket_options(socket_opts);
         ws_->set_on_raw_message([](const char *, std::size_t) {
             // Intentionally ignored; brain -> pop messages are not used yet.
         });
@@ -100,8 +104,8 @@ namespace md {
         nlohmann::json arr = nlohmann::json::array();
         for (const auto &lvl: levels) {
             arr.push_back({
-                {"price", lvl.price},
-                {"quantity", lvl.quantity},
+                {"price", std::string(lvl.price)},
+                {"quantity", std::string(lvl.quantity)},
                 {"priceTick", lvl.priceTick},
                 {"quantityLot", lvl.quantityLot}
             });
@@ -112,11 +116,13 @@ namespace md {
     nlohmann::json WsPublishSink::levels_from_book_(const OrderBook &book, std::size_t top_n, Side side) {
         nlohmann::json arr = nlohmann::json::array();
         for (std::size_t i = 0; i < top_n; ++i) {
-            const Level *lvl = (side == Side::BID) ? book.bid_ptr(i) : book.ask_ptr(i);
+            const BookLevel *lvl = (side == Side::BID) ? book.bid_ptr(i) : book.ask_ptr(i);
             if (!lvl) break;
+            // Text comes from the book's cold side table (retained by the feed handler when sinks are on).
+            const LevelText *txt = (side == Side::BID) ? book.bid_text(i) : book.ask_text(i);
             arr.push_back({
-                {"price", lvl->price},
-                {"quantity", lvl->quantity},
+                {"price", txt ? txt->price : std::string{}},
+                {"quantity", txt ? txt->quantity : std::string{}},
                 {"priceTick", lvl->priceTick},
                 {"quantityLot", lvl->quantityLot}
             });
@@ -195,6 +201,7 @@ namespace md {
         j["symbol"] = symbol_;
         j["persist_seq"] = ++persist_seq_;
         j["ts_recv_ns"] = snap.ts_recv_ns;
+        if (snap.ts_recv_kernel_ns) j["ts_recv_kernel_ns"] = snap.ts_recv_kernel_ns;
         j["ts_persist_ns"] = now_ns_();
         // GenericSnapshotFormat carries a single sequence id (lastUpdateId).
         // seq_first == seq_last here; venues that distinguish them (e.g. Binance)
@@ -217,6 +224,7 @@ namespace md {
         j["symbol"] = symbol_;
         j["persist_seq"] = ++persist_seq_;
         j["ts_recv_ns"] = inc.ts_recv_ns;
+        if (inc.ts_recv_kernel_ns) j["ts_recv_kernel_ns"] = inc.ts_recv_kernel_ns;
         j["ts_persist_ns"] = now_ns_();
         j["seq_first"] = inc.first_seq;
         j["seq_last"] = inc.last_seq;